@@ -850,8 +850,9 @@ void BOARD_ADAPTER::AddSolidAreasShapesToContainer( const ZONE_CONTAINER* aZoneC
                                                     CGENERICCONTAINER2D *aDstContainer,
                                                     PCB_LAYER_ID aLayerId )
 {
-    // Copy the polys list because we have to simplify it
-    SHAPE_POLY_SET polyList = SHAPE_POLY_SET( aZoneContainer->GetFilledPolysList(), true );
+    // The copy shares the triangulation cached when the zone was filled or loaded, so it is
+    // not triangulated again
+    SHAPE_POLY_SET polyList = aZoneContainer->GetFilledPolysList();
 
     // This convert the poly in outline and holes
     Convert_shape_line_polygon_to_triangles( polyList, *aDstContainer, m_biuTo3Dunits,
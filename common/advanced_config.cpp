@@ -80,6 +80,13 @@ static const wxChar RealtimeConnectivity[] = wxT( "RealtimeConnectivity" );
  */
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 
+/**
+ * Record the interactive router sessions (the router world, settings and the cursor events)
+ * to the given file, so router performance can be benchmarked by replaying real sessions
+ * with the qa_pcbnew_tools pns_replay utility.
+ */
+static const wxChar RouterSessionLog[] = wxT( "RouterSessionLog" );
+
 } // namespace KEYS
 
 
@@ -160,6 +167,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_EnableUsePadProperty = false;
     m_realTimeConnectivity = true;
     m_coroutineStackSize = AC_STACK::default_stack;
+    m_RouterSessionLog = wxEmptyString;
 
     loadFromConfigFile();
 }
@@ -203,6 +211,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                &m_coroutineStackSize, AC_STACK::default_stack,
                                                AC_STACK::min_stack, AC_STACK::max_stack ) );
 
+    configParams.push_back( new PARAM_CFG_WXSTRING( true, AC_KEYS::RouterSessionLog,
+                                                    &m_RouterSessionLog, wxEmptyString ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     for( auto param : configParams )
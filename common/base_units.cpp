@@ -517,8 +517,75 @@ wxString GetAbbreviatedUnitsLabel( EDA_UNITS aUnit, bool aUseMils, EDA_DATA_TYPE
 }
 
 
+/**
+ * @return the number of decimals of a value in millimeters converted from internal units,
+ * or -1 if IU_PER_MM is not a power of ten.
+ */
+static int internalUnitsDecimals()
+{
+    int       decimals = 0;
+    long long scale = 1;
+
+    while( scale < (long long) IU_PER_MM )
+    {
+        scale *= 10;
+        decimals++;
+    }
+
+    return scale == (long long) IU_PER_MM ? decimals : -1;
+}
+
+
 std::string FormatInternalUnits( int aValue )
 {
+    static const int decimals = internalUnitsDecimals();
+
+    // A value in internal units has an exact decimal representation in millimeters, which is
+    // what "%.10g" gives for all the ints (at most 10 significant digits), without exponent
+    // and trailing zeros.  Build it with integer arithmetic: this is much faster than going
+    // through a double and printf, which also depends on the locale.
+    if( decimals >= 0 )
+    {
+        char               buf[32];
+        char*              out = buf;
+        unsigned long long scale = (unsigned long long) IU_PER_MM;
+        unsigned long long value = aValue < 0 ? -(long long) aValue : aValue;
+        unsigned long long intPart = value / scale;
+        unsigned long long fracPart = value % scale;
+        char               digits[24];
+        int                count = 0;
+
+        if( aValue < 0 )
+            *out++ = '-';
+
+        do
+        {
+            digits[count++] = (char) ( '0' + intPart % 10 );
+            intPart /= 10;
+        } while( intPart );
+
+        while( count )
+            *out++ = digits[--count];
+
+        if( fracPart )
+        {
+            *out++ = '.';
+
+            for( int ii = decimals - 1; ii >= 0; --ii )
+            {
+                out[ii] = (char) ( '0' + fracPart % 10 );
+                fracPart /= 10;
+            }
+
+            out += decimals;
+
+            while( out[-1] == '0' )
+                --out;
+        }
+
+        return std::string( buf, out - buf );
+    }
+
     char    buf[50];
     double  engUnits = aValue;
     int     len;
@@ -171,6 +171,8 @@ bool EDA_TEXT::Replace( wxFindReplaceData& aSearchData )
 
 int EDA_TEXT::LenSize( const wxString& aLine, int aThickness ) const
 {
+    std::lock_guard<std::mutex> lock( basic_gal_mutex );
+
     basic_gal.SetFontItalic( IsItalic() );
     basic_gal.SetFontBold( IsBold() );
     basic_gal.SetLineWidth( (float) aThickness );
@@ -937,6 +937,34 @@ void OPENGL_GAL::DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain )
 }
 
 
+void OPENGL_GAL::DrawPolylines( const std::vector<std::vector<VECTOR2D>>& aPointLists )
+{
+    int lineQuadCount = 0;
+
+    for( const std::vector<VECTOR2D>& points : aPointLists )
+    {
+        if( points.size() > 1 )
+            lineQuadCount += points.size() - 1;
+    }
+
+    if( lineQuadCount == 0 )
+        return;
+
+    // Reserve the vertices of all the polylines at once, so they end up in a
+    // single vertex run
+    if( !currentManager->Reserve( 6 * lineQuadCount ) )
+        return;
+
+    currentManager->Color( strokeColor.r, strokeColor.g, strokeColor.b, strokeColor.a );
+
+    for( const std::vector<VECTOR2D>& points : aPointLists )
+    {
+        for( size_t i = 1; i < points.size(); ++i )
+            drawLineQuad( points[i - 1], points[i], false );
+    }
+}
+
+
 void OPENGL_GAL::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
 {
     auto points = std::unique_ptr<GLdouble[]>( new GLdouble[3 * aPointList.size()] );
@@ -981,14 +1009,19 @@ void OPENGL_GAL::drawTriangulatedPolyset( const SHAPE_POLY_SET& aPolySet )
         for( unsigned int j = 0; j < aPolySet.TriangulatedPolyCount(); ++j )
         {
             auto triPoly = aPolySet.TriangulatedPolygon( j );
+            const std::vector<VECTOR2I>& vertices = triPoly->Vertices();
 
-            for( size_t i = 0; i < triPoly->GetTriangleCount(); i++ )
+            if( triPoly->GetTriangleCount() == 0
+                    || !currentManager->Reserve( 3 * triPoly->GetTriangleCount() ) )
             {
-                VECTOR2I a, b, c;
-                triPoly->GetTriangle( i, a, b, c );
-                currentManager->Vertex( a.x, a.y, layerDepth );
-                currentManager->Vertex( b.x, b.y, layerDepth );
-                currentManager->Vertex( c.x, c.y, layerDepth );
+                continue;
+            }
+
+            for( const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI& tri : triPoly->Triangles() )
+            {
+                currentManager->Vertex( vertices[tri.a].x, vertices[tri.a].y, layerDepth );
+                currentManager->Vertex( vertices[tri.b].x, vertices[tri.b].y, layerDepth );
+                currentManager->Vertex( vertices[tri.c].x, vertices[tri.c].y, layerDepth );
             }
         }
     }
@@ -1616,7 +1649,8 @@ void OPENGL_GAL::DrawCursor( const VECTOR2D& aCursorPosition )
 }
 
 
-void OPENGL_GAL::drawLineQuad( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+void OPENGL_GAL::drawLineQuad( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                               bool aReserve )
 {
     /* Helper drawing:                   ____--- v3       ^
      *                           ____---- ...   \          \
@@ -1638,7 +1672,8 @@ void OPENGL_GAL::drawLineQuad( const VECTOR2D& aStartPoint, const VECTOR2D& aEnd
 
     VECTOR2D vs( v2.x - v1.x, v2.y - v1.y );
 
-    currentManager->Reserve( 6 );
+    if( aReserve )
+        currentManager->Reserve( 6 );
 
     // Line width is maintained by the vertex shader
     currentManager->Shader( SHADER_LINE_A, lineWidth, vs.x, vs.y );
@@ -0,0 +1,302 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/recording_gal.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+using namespace KIGFX;
+
+
+RECORDING_GAL::RECORDING_GAL( GAL* aTarget ) :
+    GAL( aTarget->options )
+{
+    SyncWith( aTarget );
+}
+
+
+void RECORDING_GAL::SyncWith( GAL* aTarget )
+{
+    worldUnitLength   = aTarget->worldUnitLength;
+    screenDPI         = aTarget->screenDPI;
+    screenSize        = aTarget->screenSize;
+    lookAtPoint       = aTarget->lookAtPoint;
+    zoomFactor        = aTarget->zoomFactor;
+    rotation          = aTarget->rotation;
+    globalFlipX       = aTarget->globalFlipX;
+    globalFlipY       = aTarget->globalFlipY;
+    depthRange        = aTarget->depthRange;
+    worldScale        = aTarget->worldScale;
+    worldScreenMatrix = aTarget->worldScreenMatrix;
+    screenWorldMatrix = aTarget->screenWorldMatrix;
+
+    m_isCairo  = aTarget->IsCairoEngine();
+    m_isOpenGl = aTarget->IsOpenGlEngine();
+}
+
+
+void RECORDING_GAL::DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    record( [=]( GAL& aGal ) { aGal.DrawLine( aStartPoint, aEndPoint ); } );
+}
+
+
+void RECORDING_GAL::DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                                 double aWidth )
+{
+    record( [=]( GAL& aGal ) { aGal.DrawSegment( aStartPoint, aEndPoint, aWidth ); } );
+}
+
+
+void RECORDING_GAL::DrawPolyline( const std::deque<VECTOR2D>& aPointList )
+{
+    record( [aPointList]( GAL& aGal ) { aGal.DrawPolyline( aPointList ); } );
+}
+
+
+void RECORDING_GAL::DrawPolyline( const VECTOR2D aPointList[], int aListSize )
+{
+    std::vector<VECTOR2D> points( aPointList, aPointList + aListSize );
+
+    record( [points]( GAL& aGal )
+            {
+                aGal.DrawPolyline( points.data(), (int) points.size() );
+            } );
+}
+
+
+void RECORDING_GAL::DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain )
+{
+    record( [aLineChain]( GAL& aGal ) { aGal.DrawPolyline( aLineChain ); } );
+}
+
+
+void RECORDING_GAL::DrawPolylines( const std::vector<std::vector<VECTOR2D>>& aPointLists )
+{
+    record( [aPointLists]( GAL& aGal ) { aGal.DrawPolylines( aPointLists ); } );
+}
+
+
+void RECORDING_GAL::DrawCircle( const VECTOR2D& aCenterPoint, double aRadius )
+{
+    record( [=]( GAL& aGal ) { aGal.DrawCircle( aCenterPoint, aRadius ); } );
+}
+
+
+void RECORDING_GAL::DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                             double aEndAngle )
+{
+    record( [=]( GAL& aGal ) { aGal.DrawArc( aCenterPoint, aRadius, aStartAngle, aEndAngle ); } );
+}
+
+
+void RECORDING_GAL::DrawArcSegment( const VECTOR2D& aCenterPoint, double aRadius,
+                                    double aStartAngle, double aEndAngle, double aWidth )
+{
+    record( [=]( GAL& aGal )
+            {
+                aGal.DrawArcSegment( aCenterPoint, aRadius, aStartAngle, aEndAngle, aWidth );
+            } );
+}
+
+
+void RECORDING_GAL::DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint )
+{
+    record( [=]( GAL& aGal ) { aGal.DrawRectangle( aStartPoint, aEndPoint ); } );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const std::deque<VECTOR2D>& aPointList )
+{
+    record( [aPointList]( GAL& aGal ) { aGal.DrawPolygon( aPointList ); } );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const VECTOR2D aPointList[], int aListSize )
+{
+    std::vector<VECTOR2D> points( aPointList, aPointList + aListSize );
+
+    record( [points]( GAL& aGal )
+            {
+                aGal.DrawPolygon( points.data(), (int) points.size() );
+            } );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const SHAPE_POLY_SET& aPolySet )
+{
+    // The copy shares the cached triangulation with the original, so zone fills
+    // are not duplicated.
+    record( [aPolySet]( GAL& aGal ) { aGal.DrawPolygon( aPolySet ); } );
+}
+
+
+void RECORDING_GAL::DrawPolygon( const SHAPE_LINE_CHAIN& aPolySet )
+{
+    record( [aPolySet]( GAL& aGal ) { aGal.DrawPolygon( aPolySet ); } );
+}
+
+
+void RECORDING_GAL::DrawCurve( const VECTOR2D& startPoint, const VECTOR2D& controlPointA,
+                               const VECTOR2D& controlPointB, const VECTOR2D& endPoint,
+                               double aFilterValue )
+{
+    record( [=]( GAL& aGal )
+            {
+                aGal.DrawCurve( startPoint, controlPointA, controlPointB, endPoint, aFilterValue );
+            } );
+}
+
+
+void RECORDING_GAL::DrawBitmap( const BITMAP_BASE& aBitmap )
+{
+    // Bitmaps belong to the drawn item, which outlives the recorded commands
+    const BITMAP_BASE* bitmap = &aBitmap;
+
+    record( [bitmap]( GAL& aGal ) { aGal.DrawBitmap( *bitmap ); } );
+}
+
+
+void RECORDING_GAL::SetIsFill( bool aIsFillEnabled )
+{
+    GAL::SetIsFill( aIsFillEnabled );
+    record( [=]( GAL& aGal ) { aGal.SetIsFill( aIsFillEnabled ); } );
+}
+
+
+void RECORDING_GAL::SetIsStroke( bool aIsStrokeEnabled )
+{
+    GAL::SetIsStroke( aIsStrokeEnabled );
+    record( [=]( GAL& aGal ) { aGal.SetIsStroke( aIsStrokeEnabled ); } );
+}
+
+
+void RECORDING_GAL::SetFillColor( const COLOR4D& aColor )
+{
+    GAL::SetFillColor( aColor );
+    record( [=]( GAL& aGal ) { aGal.SetFillColor( aColor ); } );
+}
+
+
+void RECORDING_GAL::SetStrokeColor( const COLOR4D& aColor )
+{
+    GAL::SetStrokeColor( aColor );
+    record( [=]( GAL& aGal ) { aGal.SetStrokeColor( aColor ); } );
+}
+
+
+void RECORDING_GAL::SetLineWidth( float aLineWidth )
+{
+    GAL::SetLineWidth( aLineWidth );
+    record( [=]( GAL& aGal ) { aGal.SetLineWidth( aLineWidth ); } );
+}
+
+
+void RECORDING_GAL::SetLayerDepth( double aLayerDepth )
+{
+    GAL::SetLayerDepth( aLayerDepth );
+    record( [=]( GAL& aGal ) { aGal.SetLayerDepth( aLayerDepth ); } );
+}
+
+
+void RECORDING_GAL::SetNegativeDrawMode( bool aSetting )
+{
+    record( [=]( GAL& aGal ) { aGal.SetNegativeDrawMode( aSetting ); } );
+}
+
+
+void RECORDING_GAL::BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                                double aRotationAngle )
+{
+    // Bitmap text rendering is engine specific, so keep the text and the attributes
+    // in effect now and let the target GAL lay it out.
+    VECTOR2D            glyphSize = GetGlyphSize();
+    EDA_TEXT_HJUSTIFY_T hJustify  = GetHorizontalJustify();
+    EDA_TEXT_VJUSTIFY_T vJustify  = GetVerticalJustify();
+    bool                bold      = IsFontBold();
+    bool                italic    = IsFontItalic();
+    bool                mirrored  = IsTextMirrored();
+
+    record( [=]( GAL& aGal )
+            {
+                aGal.SetGlyphSize( glyphSize );
+                aGal.SetHorizontalJustify( hJustify );
+                aGal.SetVerticalJustify( vJustify );
+                aGal.SetFontBold( bold );
+                aGal.SetFontItalic( italic );
+                aGal.SetTextMirrored( mirrored );
+                aGal.BitmapText( aText, aPosition, aRotationAngle );
+            } );
+}
+
+
+void RECORDING_GAL::Transform( const MATRIX3x3D& aTransformation )
+{
+    record( [=]( GAL& aGal ) { aGal.Transform( aTransformation ); } );
+}
+
+
+void RECORDING_GAL::Rotate( double aAngle )
+{
+    record( [=]( GAL& aGal ) { aGal.Rotate( aAngle ); } );
+}
+
+
+void RECORDING_GAL::Translate( const VECTOR2D& aTranslation )
+{
+    record( [=]( GAL& aGal ) { aGal.Translate( aTranslation ); } );
+}
+
+
+void RECORDING_GAL::Scale( const VECTOR2D& aScale )
+{
+    record( [=]( GAL& aGal ) { aGal.Scale( aScale ); } );
+}
+
+
+void RECORDING_GAL::Save()
+{
+    record( []( GAL& aGal ) { aGal.Save(); } );
+}
+
+
+void RECORDING_GAL::Restore()
+{
+    record( []( GAL& aGal ) { aGal.Restore(); } );
+}
+
+
+std::vector<RECORDING_GAL::COMMAND> RECORDING_GAL::TakeCommands()
+{
+    std::vector<COMMAND> commands;
+    commands.swap( m_commands );
+    return commands;
+}
+
+
+void RECORDING_GAL::Replay( const std::vector<COMMAND>& aCommands, GAL* aGal )
+{
+    for( const COMMAND& command : aCommands )
+        command( *aGal );
+}
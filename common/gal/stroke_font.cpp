@@ -331,6 +331,22 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
     bool     in_super_or_subscript = false;
     VECTOR2D glyphSize = baseGlyphSize;
 
+    // All the strokes of the line (glyphs and overbars) are gathered and handed over
+    // to the GAL in one call, so it can emit them as a single batch
+    std::vector<std::vector<VECTOR2D>>& strokes = m_strokeBuffer;
+    size_t strokeCount = 0;
+
+    auto newStroke =
+            [&]() -> std::vector<VECTOR2D>&
+            {
+                if( strokeCount == strokes.size() )
+                    strokes.emplace_back();
+
+                std::vector<VECTOR2D>& stroke = strokes[strokeCount++];
+                stroke.clear();
+                return stroke;
+            };
+
     yOffset = 0;
 
     for( UTF8::uni_iter chIt = aText.ubegin(), end = aText.uend(); chIt < end; ++chIt )
@@ -442,10 +458,10 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 last_had_overbar = true;
             }
 
-            VECTOR2D startOverbar( overbar_start_x, overbar_start_y );
-            VECTOR2D endOverbar( overbar_end_x, overbar_end_y );
+            std::vector<VECTOR2D>& overbar = newStroke();
 
-            m_gal->DrawLine( startOverbar, endOverbar );
+            overbar.emplace_back( overbar_start_x, overbar_start_y );
+            overbar.emplace_back( overbar_end_x, overbar_end_y );
         }
         else
         {
@@ -454,7 +470,8 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 
         for( const std::vector<VECTOR2D>* ptList : *glyph )
         {
-            std::deque<VECTOR2D> ptListScaled;
+            std::vector<VECTOR2D>& ptListScaled = newStroke();
+            ptListScaled.reserve( ptList->size() );
 
             for( const VECTOR2D& pt : *ptList )
             {
@@ -472,13 +489,18 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 
                 ptListScaled.push_back( scaledPt );
             }
-
-            m_gal->DrawPolyline( ptListScaled );
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
     }
 
+    // The buffer is kept between calls to avoid reallocating the strokes for each text;
+    // the leftovers from a longer text are emptied (and thus skipped) rather than freed
+    for( size_t i = strokeCount; i < strokes.size(); ++i )
+        strokes[i].clear();
+
+    m_gal->DrawPolylines( strokes );
+
     m_gal->Restore();
 }
 
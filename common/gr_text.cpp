@@ -91,6 +91,8 @@ int Clamp_Text_PenSize( int aPenSize, wxSize aSize, bool aBold )
 
 int GraphicTextWidth( const wxString& aText, const wxSize& aSize, bool aItalic, bool aBold )
 {
+    std::lock_guard<std::mutex> lock( basic_gal_mutex );
+
     basic_gal.SetFontItalic( aItalic );
     basic_gal.SetFontBold( aBold );
     basic_gal.SetGlyphSize( VECTOR2D( aSize ) );
@@ -142,9 +144,6 @@ void GRText( wxDC* aDC, const wxPoint& aPos, COLOR4D aColor, const wxString& aTe
         fill_mode = false;
     }
 
-    basic_gal.SetIsFill( fill_mode );
-    basic_gal.SetLineWidth( aWidth );
-
     EDA_TEXT dummy;
     dummy.SetItalic( aItalic );
     dummy.SetBold( aBold );
@@ -159,6 +158,10 @@ void GRText( wxDC* aDC, const wxPoint& aPos, COLOR4D aColor, const wxString& aTe
 
     dummy.SetTextSize( size );
 
+    std::lock_guard<std::mutex> lock( basic_gal_mutex );
+
+    basic_gal.SetIsFill( fill_mode );
+    basic_gal.SetLineWidth( aWidth );
     basic_gal.SetTextAttributes( &dummy );
     basic_gal.SetPlotter( aPlotter );
     basic_gal.SetCallback( aCallback, aCallbackData );
@@ -184,17 +184,7 @@ bool GERBER_PLOTTER::StartPlot()
 {
     wxASSERT( outputFile );
 
-    finalFile = outputFile;     // the actual gerber file will be created later
-
-    // Create a temporary filename to store gerber file
-    // note tmpfile() does not work under Vista and W7 in user mode
-    m_workFilename = filename + wxT(".tmp");
-    workFile   = wxFopen( m_workFilename, wxT( "wt" ));
-    outputFile = workFile;
-    wxASSERT( outputFile );
-
-    if( outputFile == NULL )
-        return false;
+    finalFile = outputFile;     // the header is written in the actual gerber file
 
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
@@ -239,15 +229,26 @@ bool GERBER_PLOTTER::StartPlot()
     // Set aperture list starting point:
     fputs( "G04 APERTURE LIST*\n", outputFile );
 
+    // The aperture list is known only at the end of the plot: the plot itself is stored
+    // in a work file, appended to the gerber file after the aperture list in EndPlot().
+    // note tmpfile() does not work under Vista and W7 in user mode
+    m_workFilename = filename + wxT(".tmp");
+    workFile   = wxFopen( m_workFilename, wxT( "wt" ));
+    outputFile = workFile;
+    wxASSERT( outputFile );
+
+    if( outputFile == NULL )
+    {
+        outputFile = finalFile;
+        return false;
+    }
+
     return true;
 }
 
 
 bool GERBER_PLOTTER::EndPlot()
 {
-    char     line[1024];
-    wxString msg;
-
     wxASSERT( outputFile );
 
     /* Outfile is actually a temporary file i.e. workFile */
@@ -259,21 +260,22 @@ bool GERBER_PLOTTER::EndPlot()
     wxASSERT( workFile );
     outputFile = finalFile;
 
-    // Placement of apertures in RS274X
-    while( fgets( line, 1024, workFile ) )
+    // Placement of apertures in RS274X: the header is already written, so the
+    // aperture list is now written, followed by the plot itself
+    writeApertureList();
+    fputs( "G04 APERTURE END LIST*\n", outputFile );
+
+    if( workFile )
     {
-        fputs( line, outputFile );
+        char   buffer[65536];
+        size_t count;
 
-        char* substr = strtok( line, "\n\r" );
+        while( ( count = fread( buffer, 1, sizeof( buffer ), workFile ) ) > 0 )
+            fwrite( buffer, 1, count, outputFile );
 
-        if( substr && strcmp( substr, "G04 APERTURE LIST*" ) == 0 )
-        {
-            writeApertureList();
-            fputs( "G04 APERTURE END LIST*\n", outputFile );
-        }
+        fclose( workFile );
     }
 
-    fclose( workFile );
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
     outputFile = 0;
@@ -295,21 +297,28 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int aWidth, void* aData )
 }
 
 
+size_t GERBER_PLOTTER::APERTURE_KEY_HASH::operator()( const APERTURE_KEY& aKey ) const
+{
+    size_t seed = std::hash<int>()( aKey.m_Type );
+
+    for( int value : { aKey.m_Size.x, aKey.m_Size.y, aKey.m_ApertureAttribute } )
+        seed ^= std::hash<int>()( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+
+    return seed;
+}
+
+
 int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
                         APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
 {
-    int last_D_code = 9;
-
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+    APERTURE_KEY key = { aType, aSize, aApertureAttribute };
+    auto         it = m_apertureIndex.find( key );
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return idx;
-    }
+    if( it != m_apertureIndex.end() )
+        return it->second;
+
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -319,6 +328,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
+    m_apertureIndex[key] = m_apertures.size() - 1;
 
     return m_apertures.size() - 1;
 }
@@ -579,6 +589,43 @@ void GERBER_PLOTTER::PlotGerberRegion( const std::vector< wxPoint >& aCornerList
     }
 }
 
+void GERBER_PLOTTER::PlotPolyRegions( const std::vector< std::vector< wxPoint > >& aContours,
+                                      void* aData )
+{
+    GBR_METADATA* gbr_metadata = static_cast<GBR_METADATA*>( aData );
+    bool          regionStarted = false;
+
+    for( const std::vector< wxPoint >& contour : aContours )
+    {
+        if( contour.size() <= 1 )
+            continue;
+
+        if( !regionStarted )
+        {
+            if( gbr_metadata )
+                formatNetAttribute( &gbr_metadata->m_NetlistMetadata );
+
+            fputs( "G36*\n", outputFile );
+            fputs( "G01*\n", outputFile );      // Set linear interpolation.
+            regionStarted = true;
+        }
+
+        // Each contour starts with a D02 command, and creates its own region object
+        MoveTo( contour[0] );
+
+        for( unsigned ii = 1; ii < contour.size(); ii++ )
+            LineTo( contour[ii] );
+
+        // If the polygon is not closed, close it:
+        if( contour[0] != contour[contour.size()-1] )
+            FinishTo( contour[0] );
+    }
+
+    if( regionStarted )
+        fputs( "G37*\n", outputFile );
+}
+
+
 void GERBER_PLOTTER::PlotPoly( const std::vector< wxPoint >& aCornerList,
                                FILL_T aFill, int aWidth, void * aData )
 {
@@ -42,7 +42,8 @@ NESTED_SETTINGS::NESTED_SETTINGS( const std::string& aName, int aVersion, JSON_S
 
 NESTED_SETTINGS::~NESTED_SETTINGS()
 {
-    m_parent->ReleaseNestedSettings( this );
+    if( m_parent )
+        m_parent->ReleaseNestedSettings( this );
 }
 
 
@@ -35,16 +35,24 @@
 
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <gal/recording_gal.h>
 #include <painter.h>
 
 #ifdef __WXDEBUG__
 #include <profile.h>
 #endif /* __WXDEBUG__  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 namespace KIGFX {
 
 class VIEW;
 
+///> Number of items with geometry to redraw above which the drawing is done in parallel
+static const size_t PARALLEL_REDRAW_THRESHOLD = 1000;
+
 class VIEW_ITEM_DATA
 {
 public:
@@ -1213,7 +1221,7 @@ void VIEW::clearGroupCache()
 }
 
 
-void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
+void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags, std::vector<int>* aDeferredLayers )
 {
     if( aUpdateFlags & INITIAL_ADD )
     {
@@ -1245,7 +1253,12 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         if( IsCached( layerId ) )
         {
             if( aUpdateFlags & ( GEOMETRY | LAYERS | REPAINT ) )
-                updateItemGeometry( aItem, layerId );
+            {
+                if( aDeferredLayers )
+                    aDeferredLayers->push_back( layerId );
+                else
+                    updateItemGeometry( aItem, layerId );
+            }
             else if( aUpdateFlags & COLOR )
                 updateItemColor( aItem, layerId );
         }
@@ -1292,7 +1305,8 @@ void VIEW::updateItemColor( VIEW_ITEM* aItem, int aLayer )
 }
 
 
-void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
+void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer,
+                               const std::vector<std::function<void( GAL& )>>* aRecorded )
 {
     auto viewData = aItem->viewPrivData();
     wxCHECK( (unsigned) aLayer < m_layers.size(), /*void*/ );
@@ -1315,13 +1329,116 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
-    if( !m_painter->Draw( static_cast<EDA_ITEM*>( aItem ), aLayer ) )
+    if( aRecorded )
+        RECORDING_GAL::Replay( *aRecorded, m_gal );
+    else if( !m_painter->Draw( static_cast<EDA_ITEM*>( aItem ), aLayer ) )
         aItem->ViewDraw( aLayer, this ); // Alternative drawing method
 
     m_gal->EndGroup();
 }
 
 
+void VIEW::updateItemsParallel( const std::vector<VIEW_ITEM*>& aItems )
+{
+    struct ITEM_JOB
+    {
+        VIEW_ITEM*                                       item;
+        std::vector<int>                                 layers;
+        std::vector<std::vector<RECORDING_GAL::COMMAND>> commands;
+        std::vector<char>                                recorded;
+    };
+
+    std::vector<ITEM_JOB> jobs;
+    jobs.reserve( aItems.size() );
+
+    // Layer and bounding box updates touch the view structures, so they stay on this thread.
+    // Only the geometry redraw is postponed.
+    for( VIEW_ITEM* item : aItems )
+    {
+        auto viewData = item->viewPrivData();
+        ITEM_JOB job;
+
+        job.item = item;
+        invalidateItem( item, viewData->m_requiredUpdate, &job.layers );
+        viewData->m_requiredUpdate = NONE;
+
+        if( !job.layers.empty() )
+            jobs.push_back( std::move( job ) );
+    }
+
+    if( jobs.empty() )
+        return;
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   jobs.size() );
+
+    // Recorders subscribe to the GAL display options, so they are created here rather
+    // than in the worker threads
+    std::vector<std::unique_ptr<RECORDING_GAL>> recorders;
+    std::vector<std::unique_ptr<PAINTER>>       painters;
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        recorders.emplace_back( new RECORDING_GAL( m_gal ) );
+        painters.emplace_back( m_painter->Clone( recorders.back().get() ) );
+    }
+
+    std::atomic<size_t> nextJob( 0 );
+
+    auto recordJobs = [&]( size_t aThread ) -> size_t
+    {
+        RECORDING_GAL* recorder = recorders[aThread].get();
+        PAINTER*       painter = painters[aThread].get();
+        size_t         num = 0;
+
+        for( size_t i = nextJob.fetch_add( 1 ); i < jobs.size(); i = nextJob.fetch_add( 1 ) )
+        {
+            ITEM_JOB& job = jobs[i];
+
+            job.commands.resize( job.layers.size() );
+            job.recorded.resize( job.layers.size(), false );
+
+            // All layers of an item are drawn by the same thread, as painters may
+            // temporarily modify the item they draw
+            for( size_t ii = 0; ii < job.layers.size(); ++ii )
+            {
+                recorder->Clear();
+
+                if( painter->Draw( static_cast<EDA_ITEM*>( job.item ), job.layers[ii] ) )
+                {
+                    job.commands[ii] = recorder->TakeCommands();
+                    job.recorded[ii] = true;
+                }
+            }
+
+            num++;
+        }
+
+        return num;
+    };
+
+    std::vector<std::future<size_t>> returns;
+    returns.reserve( parallelThreadCount );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns.emplace_back( std::async( std::launch::async, recordJobs, ii ) );
+
+    for( auto& ret : returns )
+        ret.wait();
+
+    // Upload the recorded geometry.  Items the painter could not handle are drawn the
+    // usual way (VIEW_ITEM::ViewDraw() is not expected to be thread safe).
+    for( ITEM_JOB& job : jobs )
+    {
+        for( size_t ii = 0; ii < job.layers.size(); ++ii )
+        {
+            updateItemGeometry( job.item, job.layers[ii],
+                                job.recorded[ii] ? &job.commands[ii] : nullptr );
+        }
+    }
+}
+
+
 void VIEW::updateBbox( VIEW_ITEM* aItem )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
@@ -1424,6 +1541,9 @@ void VIEW::UpdateItems()
     {
         GAL_UPDATE_CONTEXT ctx( m_gal );
 
+        std::vector<VIEW_ITEM*> redrawList;
+        size_t                  redrawCount = 0;
+
         for( VIEW_ITEM* item : *m_allItems )
         {
             auto viewData = item->viewPrivData();
@@ -1433,10 +1553,29 @@ void VIEW::UpdateItems()
 
             if( viewData->m_requiredUpdate != NONE )
             {
-                invalidateItem( item, viewData->m_requiredUpdate );
-                viewData->m_requiredUpdate = NONE;
+                redrawList.push_back( item );
+
+                if( viewData->m_requiredUpdate & ( INITIAL_ADD | GEOMETRY | LAYERS | REPAINT ) )
+                    redrawCount++;
             }
         }
+
+        // Drawing items in parallel pays off only when there is a lot of geometry to redraw
+        // (e.g. a board has been loaded or the display options have changed)
+        if( redrawCount >= PARALLEL_REDRAW_THRESHOLD && std::thread::hardware_concurrency() > 1
+                && m_painter->CanClone() )
+        {
+            updateItemsParallel( redrawList );
+            return;
+        }
+
+        for( VIEW_ITEM* item : redrawList )
+        {
+            auto viewData = item->viewPrivData();
+
+            invalidateItem( item, viewData->m_requiredUpdate );
+            viewData->m_requiredUpdate = NONE;
+        }
     }
 }
 
@@ -1915,59 +1915,187 @@ std::vector<const CONNECTION_SUBGRAPH*> CONNECTION_GRAPH::GetBusesNeedingMigrati
 
 int CONNECTION_GRAPH::RunERC()
 {
-    int error_count = 0;
+    PROF_COUNTER erc_time;
 
-    for( auto&& subgraph : m_subgraphs )
+    enum ERC_RULE
     {
-        // Graph is supposed to be up-to-date before calling RunERC()
-        wxASSERT( !subgraph->m_dirty );
+        RULE_DRIVERS,
+        RULE_BUS_TO_NET,
+        RULE_BUS_ENTRY,
+        RULE_BUS_TO_BUS,
+        RULE_NO_CONNECTS,
+        RULE_LABELS,
+        RULE_COUNT
+    };
+
+    static const char* ruleNames[RULE_COUNT] =
+    {
+        "drivers", "bus to net", "bus entries", "bus to bus", "no connects", "labels"
+    };
+
+    bool checkDrivers   = g_ErcSettings->IsTestEnabled( ERCE_DRIVER_CONFLICT );
+    bool checkBusToNet  = g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT );
+    bool checkBusEntry  = g_ErcSettings->IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT );
+    bool checkBusToBus  = g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT );
+    bool checkLabels    = g_ErcSettings->IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
+                              || g_ErcSettings->IsTestEnabled( ERCE_GLOBLABEL );
+
+    // Each rule only looks at its own subgraph and at the name caches, which are not modified
+    // here, so the subgraphs are checked in parallel.  Violations are kept per subgraph and
+    // reported afterwards in subgraph order, so the markers don't depend on thread scheduling.
+    // Drivers are re-resolved in a first pass of their own because the label check reads the
+    // drivers of the hierarchical parent subgraph.
+    std::vector<std::vector<ERC_VIOLATION>> violations( m_subgraphs.size() );
+    std::atomic<int>    error_count( 0 );
+    std::atomic<size_t> nextSubgraph( 0 );
+    std::mutex          timesLock;
+    double              ruleTimes[RULE_COUNT] = {};
+
+    auto erc_lambda = [&]( bool aDriversPass ) -> size_t
+    {
+        double       times[RULE_COUNT] = {};
+        PROF_COUNTER lap;
+        int          errors = 0;
+
+        auto countRule = [&]( ERC_RULE aRule, bool aPassed )
+        {
+            times[aRule] += lap.msecs( true );
+
+            if( !aPassed )
+                errors++;
+        };
+
+        for( size_t ii = nextSubgraph++; ii < m_subgraphs.size(); ii = nextSubgraph++ )
+        {
+            CONNECTION_SUBGRAPH*        subgraph = m_subgraphs[ii];
+            std::vector<ERC_VIOLATION>& found = violations[ii];
+
+            // Graph is supposed to be up-to-date before calling RunERC()
+            wxASSERT( !subgraph->m_dirty );
+
+            /**
+             * NOTE:
+             *
+             * We could check that labels attached to bus subgraphs follow the
+             * proper format (i.e. actually define a bus).
+             *
+             * This check doesn't need to be here right now because labels
+             * won't actually be connected to bus wires if they aren't in the right
+             * format due to their TestDanglingEnds() implementation.
+             */
+
+            lap.msecs( true );
+
+            if( aDriversPass )
+            {
+                countRule( RULE_DRIVERS, subgraph->ResolveDrivers() );
+                continue;
+            }
+
+            if( checkBusToNet )
+                countRule( RULE_BUS_TO_NET, ercCheckBusToNetConflicts( subgraph, found ) );
+
+            if( checkBusEntry )
+                countRule( RULE_BUS_ENTRY, ercCheckBusToBusEntryConflicts( subgraph, found ) );
+
+            if( checkBusToBus )
+                countRule( RULE_BUS_TO_BUS, ercCheckBusToBusConflicts( subgraph, found ) );
+
+            // The following checks are always performed since they don't currently
+            // have an option exposed to the user
+
+            countRule( RULE_NO_CONNECTS, ercCheckNoConnects( subgraph, found ) );
+
+            if( checkLabels )
+                countRule( RULE_LABELS, ercCheckLabels( subgraph, found ) );
+        }
+
+        error_count += errors;
+
+        std::lock_guard<std::mutex> lock( timesLock );
+
+        for( int rule = 0; rule < RULE_COUNT; ++rule )
+            ruleTimes[rule] += times[rule];
+
+        return 1;
+    };
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   std::max<size_t>( m_subgraphs.size(), 1 ) );
+
+    auto run_pass = [&]( bool aDriversPass )
+    {
+        nextSubgraph = 0;
+
+        if( parallelThreadCount <= 1 )
+        {
+            erc_lambda( aDriversPass );
+        }
+        else
+        {
+            std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, erc_lambda, aDriversPass );
 
-        /**
-         * NOTE:
-         *
-         * We could check that labels attached to bus subgraphs follow the
-         * proper format (i.e. actually define a bus).
-         *
-         * This check doesn't need to be here right now because labels
-         * won't actually be connected to bus wires if they aren't in the right
-         * format due to their TestDanglingEnds() implementation.
-         */
-
-        if( g_ErcSettings->IsTestEnabled( ERCE_DRIVER_CONFLICT ) && !subgraph->ResolveDrivers() )
-            error_count++;
-
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_NET_CONFLICT )
-                && !ercCheckBusToNetConflicts( subgraph ) )
-            error_count++;
-
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_ENTRY_CONFLICT )
-                && !ercCheckBusToBusEntryConflicts( subgraph ) )
-            error_count++;
-
-        if( g_ErcSettings->IsTestEnabled( ERCE_BUS_TO_BUS_CONFLICT )
-                && !ercCheckBusToBusConflicts( subgraph ) )
-            error_count++;
-
-        // The following checks are always performed since they don't currently
-        // have an option exposed to the user
-
-        if( !ercCheckNoConnects( subgraph ) )
-            error_count++;
-
-        if( ( g_ErcSettings->IsTestEnabled( ERCE_LABEL_NOT_CONNECTED )
-                || g_ErcSettings->IsTestEnabled( ERCE_GLOBLABEL ) ) && !ercCheckLabels( subgraph ) )
-            error_count++;
+            // Finalize the threads
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii].wait();
+        }
+    };
+
+    if( checkDrivers )
+        run_pass( true );
+
+    run_pass( false );
+
+    // Markers are created and added to the screens here, on the calling thread
+    for( size_t ii = 0; ii < m_subgraphs.size(); ++ii )
+    {
+        for( const ERC_VIOLATION& violation : violations[ii] )
+            reportErcViolation( m_subgraphs[ii], violation );
     }
 
+    for( int rule = 0; rule < RULE_COUNT; ++rule )
+    {
+        wxLogTrace( "CONN_PROFILE", "RunERC() %s: %0.4f ms (all threads)", ruleNames[rule],
+                    ruleTimes[rule] );
+    }
+
+    wxLogTrace( "CONN_PROFILE", "RunERC() %zu subgraphs on %zu threads: %0.4f ms",
+                m_subgraphs.size(), parallelThreadCount, erc_time.msecs() );
+
     return error_count;
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+void CONNECTION_GRAPH::reportErcViolation( const CONNECTION_SUBGRAPH* aSubgraph,
+                                           const ERC_VIOLATION& aViolation )
 {
-    auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
+    SCH_MARKER* marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
+
+    // Pin connection problems are described by the pin and its parent component's reference
+    if( aViolation.m_ErrorCode == ERCE_NOCONNECT_CONNECTED
+            || aViolation.m_ErrorCode == ERCE_PIN_NOT_CONNECTED )
+    {
+        SCH_PIN* pin = static_cast<SCH_PIN*>( aViolation.m_MainItem );
+
+        marker->SetData( aViolation.m_ErrorCode, aViolation.m_Pos,
+                         pin->GetDescription( &aSubgraph->m_sheet ), pin->m_Uuid );
+    }
+    else
+    {
+        marker->SetData( m_frame->GetUserUnits(), aViolation.m_ErrorCode, aViolation.m_Pos,
+                         aViolation.m_MainItem, aViolation.m_AuxItem );
+    }
+
+    aSubgraph->m_sheet.LastScreen()->Append( marker );
+}
 
+
+bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                  std::vector<ERC_VIOLATION>& aViolations )
+{
     SCH_ITEM* net_item = nullptr;
     SCH_ITEM* bus_item = nullptr;
     SCH_CONNECTION conn;
@@ -2006,10 +2134,8 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
     if( net_item && bus_item )
     {
-        auto marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-        marker->SetData( m_frame->GetUserUnits(), ERCE_BUS_TO_NET_CONFLICT,
-                         net_item->GetPosition(), net_item, bus_item );
-        screen->Append( marker );
+        aViolations.push_back( { ERCE_BUS_TO_NET_CONFLICT, net_item->GetPosition(),
+                                 net_item, bus_item } );
 
         return false;
     }
@@ -2018,11 +2144,11 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                  std::vector<ERC_VIOLATION>& aViolations )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     SCH_ITEM* label = nullptr;
     SCH_ITEM* port = nullptr;
@@ -2073,10 +2199,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
         if( !match )
         {
-            auto marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-            marker->SetData( m_frame->GetUserUnits(), ERCE_BUS_TO_BUS_CONFLICT,
-                             label->GetPosition(), label, port );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_BUS_TO_BUS_CONFLICT, label->GetPosition(),
+                                     label, port } );
 
             return false;
         }
@@ -2086,11 +2210,11 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 }
 
 
-bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                                       std::vector<ERC_VIOLATION>& aViolations )
 {
     bool conflict = false;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     SCH_BUS_WIRE_ENTRY* bus_entry = nullptr;
     SCH_ITEM* bus_wire = nullptr;
@@ -2152,10 +2276,8 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
     if( conflict )
     {
-        auto marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-        marker->SetData( m_frame->GetUserUnits(), ERCE_BUS_ENTRY_CONFLICT,
-                         bus_entry->GetPosition(), bus_entry, bus_wire );
-        screen->Append( marker );
+        aViolations.push_back( { ERCE_BUS_ENTRY_CONFLICT, bus_entry->GetPosition(),
+                                 bus_entry, bus_wire } );
 
         return false;
     }
@@ -2165,11 +2287,11 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
 
 // TODO(JE) Check sheet pins here too?
-bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
+                                           std::vector<ERC_VIOLATION>& aViolations )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     if( aSubgraph->m_no_connect != nullptr )
     {
@@ -2204,20 +2326,17 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 
         if( pin && has_invalid_items )
         {
-            auto marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-            marker->SetData( ERCE_NOCONNECT_CONNECTED, pin->GetTransformedPosition(),
-                             pin->GetDescription( &aSubgraph->m_sheet ), pin->m_Uuid );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_NOCONNECT_CONNECTED, pin->GetTransformedPosition(),
+                                     pin, nullptr } );
 
             return false;
         }
 
         if( !has_other_items )
         {
-            SCH_MARKER* marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-            marker->SetData( m_frame->GetUserUnits(), ERCE_NOCONNECT_NOT_CONNECTED,
-                             aSubgraph->m_no_connect->GetPosition(), aSubgraph->m_no_connect );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_NOCONNECT_NOT_CONNECTED,
+                                     aSubgraph->m_no_connect->GetPosition(),
+                                     aSubgraph->m_no_connect, nullptr } );
 
             return false;
         }
@@ -2268,10 +2387,8 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 
         if( pin && !has_other_connections && pin->GetType() != ELECTRICAL_PINTYPE::PT_NC )
         {
-            SCH_MARKER* marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-            marker->SetData( ERCE_PIN_NOT_CONNECTED, pin->GetTransformedPosition(),
-                             pin->GetDescription( &aSubgraph->m_sheet ), pin->m_Uuid );
-            screen->Append( marker );
+            aViolations.push_back( { ERCE_PIN_NOT_CONNECTED, pin->GetTransformedPosition(),
+                                     pin, nullptr } );
 
             return false;
         }
@@ -2281,7 +2398,8 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph
 }
 
 
-bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
+bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
+                                       std::vector<ERC_VIOLATION>& aViolations )
 {
     // Label connection rules:
     // Local labels are flagged if they don't connect to any pins and don't have a no-connect
@@ -2359,11 +2477,8 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph )
 
     if( !has_other_connections )
     {
-        SCH_MARKER* marker = new SCH_MARKER( MARKER_BASE::MARKER_ERC );
-        marker->SetData( m_frame->GetUserUnits(),
-                         is_global ? ERCE_GLOBLABEL : ERCE_LABEL_NOT_CONNECTED,
-                         text->GetPosition(), text );
-        aSubgraph->m_sheet.LastScreen()->Append( marker );
+        aViolations.push_back( { is_global ? ERCE_GLOBLABEL : ERCE_LABEL_NOT_CONNECTED,
+                                 text->GetPosition(), text, nullptr } );
 
         return false;
     }
@@ -252,6 +252,10 @@ public:
     /**
      * Runs electrical rule checks on the connectivity graph.
      *
+     * The subgraphs are checked concurrently; the resulting markers are added in subgraph
+     * order so the results don't depend on the thread count.  Per-rule timings are traced
+     * under "CONN_PROFILE".
+     *
      * Precondition: graph is up-to-date
      *
      * @return the number of errors found
@@ -394,6 +398,27 @@ private:
      */
     std::shared_ptr<SCH_CONNECTION> getDefaultConnection( SCH_ITEM* aItem, SCH_SHEET_PATH aSheet );
 
+    /**
+     * An ERC violation found by one of the subgraph checks.
+     *
+     * The checks run concurrently across subgraphs, so they only record what they found;
+     * the markers are created afterwards by reportErcViolation().
+     */
+    struct ERC_VIOLATION
+    {
+        int       m_ErrorCode;
+        wxPoint   m_Pos;
+        SCH_ITEM* m_MainItem;
+        SCH_ITEM* m_AuxItem;
+    };
+
+    /**
+     * Creates the marker for a violation found in \a aSubgraph and adds it to the screen of
+     * the subgraph's sheet.  Must be called from the main thread.
+     */
+    void reportErcViolation( const CONNECTION_SUBGRAPH* aSubgraph,
+                             const ERC_VIOLATION& aViolation );
+
     void recacheSubgraphName( CONNECTION_SUBGRAPH* aSubgraph, const wxString& aOldName );
 
     /**
@@ -402,9 +427,11 @@ private:
      * For example, a net wire connected to a bus port/pin, or vice versa
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    receives the violation found, if any
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                    std::vector<ERC_VIOLATION>& aViolations );
 
     /**
      * Checks one subgraph for conflicting connections between two bus items
@@ -414,9 +441,11 @@ private:
      * sheet pin
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    receives the violation found, if any
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                    std::vector<ERC_VIOLATION>& aViolations );
 
     /**
      * Checks one subgraph for conflicting bus entry to bus connections
@@ -428,9 +457,11 @@ private:
      * "USB.DP" but someone might accidentally just enter "DP"
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    receives the violation found, if any
      * @return                true for no errors, false for errors
      */
-    bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
+                                         std::vector<ERC_VIOLATION>& aViolations );
 
     /**
      * Checks one subgraph for proper presence or absence of no-connect symbols
@@ -439,9 +470,11 @@ private:
      * A pin without a no-connect symbol should have at least one connection
      *
      * @param  aSubgraph      is the subgraph to examine
+     * @param  aViolations    receives the violation found, if any
      * @return                true for no errors, false for errors
      */
-    bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
+                             std::vector<ERC_VIOLATION>& aViolations );
 
     /**
      * Checks one subgraph for proper connection of labels
@@ -450,9 +483,11 @@ private:
      *
      * @param  aSubgraph      is the subgraph to examine
      * @param  aCheckGlobalLabels is true if global labels should be checked for loneliness
+     * @param  aViolations    receives the violation found, if any
      * @return                true for no errors, false for errors
      */
-    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph );
+    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
+                         std::vector<ERC_VIOLATION>& aViolations );
 
 };
 
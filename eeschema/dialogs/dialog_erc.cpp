@@ -47,6 +47,7 @@
 #include <confirm.h>
 #include <wx/ffile.h>
 #include <erc_item.h>
+#include <profile.h>
 #include <eeschema_settings.h>
 
 DIALOG_ERC::DIALOG_ERC( SCH_EDIT_FRAME* parent ) :
@@ -239,6 +240,8 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
     // The lastItem variable is used as a helper to pass the last item's number from one loop
     // iteration to the next, which simplifies the initial pass.
     aReporter.ReportTail( _( "Checking connections...\n" ), RPT_SEVERITY_INFO );
+    PROF_COUNTER connections_time;
+
     for( unsigned itemIdx = 0; itemIdx < objectsConnectedList->size(); itemIdx++ )
     {
         auto item = objectsConnectedList->GetItem( itemIdx );
@@ -308,6 +311,8 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
         lastItemIdx = itemIdx;
     }
 
+    wxLogTrace( "CONN_PROFILE", "ERC pin connections %0.4f ms", connections_time.msecs() );
+
     // Test similar labels (i;e. labels which are identical when
     // using case insensitive comparisons)
     if( g_ErcSettings->IsTestEnabled( ERCE_SIMILAR_LABELS ) )
@@ -212,21 +212,27 @@ void NETLIST_EXPORTER::CreatePinList( SCH_COMPONENT* comp, SCH_SHEET_PATH* aShee
 bool NETLIST_EXPORTER::addPinToComponentPinList( SCH_COMPONENT* aComponent,
    SCH_SHEET_PATH* aSheetPath, LIB_PIN* aPin )
 {
-    // Search the PIN description for Pin in g_NetObjectslist
-    for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
+    // Index the pins of g_NetObjectslist once; scanning the whole list for each pin
+    // of each component is quadratic on large designs.
+    if( m_pinIndex.empty() )
     {
-        NETLIST_OBJECT* pin = m_masterList->GetItem( ii );
+        for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
+        {
+            NETLIST_OBJECT* pin = m_masterList->GetItem( ii );
 
-        if( pin->m_Type != NETLIST_ITEM::PIN )
-            continue;
+            if( pin->m_Type == NETLIST_ITEM::PIN )
+                m_pinIndex[ std::make_pair( pin->m_Link, pin->m_PinNum ) ].push_back( pin );
+        }
+    }
 
-        if( pin->m_Link != aComponent )
-            continue;
+    auto it = m_pinIndex.find( std::make_pair( (SCH_ITEM*) aComponent, aPin->GetNumber() ) );
 
-        if( pin->m_PinNum != aPin->GetNumber() )
-            continue;
+    if( it == m_pinIndex.end() )
+        return false;
 
-        // most expensive test at the end.
+    // Search the PIN description for Pin in g_NetObjectslist
+    for( NETLIST_OBJECT* pin : it->second )
+    {
         if( pin->m_SheetPath != *aSheetPath )
             continue;
 
@@ -301,38 +307,53 @@ void NETLIST_EXPORTER::eraseDuplicatePins()
 void NETLIST_EXPORTER::findAllUnitsOfComponent( SCH_COMPONENT* aComponent,
         LIB_PART* aEntry, SCH_SHEET_PATH* aSheetPath )
 {
-    wxString    ref = aComponent->GetRef( aSheetPath );
-    wxString    ref2;
-
-    SCH_SHEET_LIST sheetList( g_RootSheet );
+    wxString ref = aComponent->GetRef( aSheetPath );
 
-    for( unsigned i = 0;  i < sheetList.size();  i++ )
+    for( const auto& unit : getUnitsOfReference( ref ) )
     {
-        for( auto item : sheetList[i].LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
+        SCH_COMPONENT*  comp2 = unit.first;
+        SCH_SHEET_PATH* sheet2 = unit.second;
+
+        int unit2 = comp2->GetUnitSelection( sheet2 );  // slow
+
+        for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
         {
-            SCH_COMPONENT* comp2 = static_cast<SCH_COMPONENT*>( item );
+            wxASSERT( pin->Type() == LIB_PIN_T );
 
-            ref2 = comp2->GetRef( &sheetList[i] );
+            if( pin->GetUnit() && pin->GetUnit() != unit2 )
+                continue;
 
-            if( ref2.CmpNoCase( ref ) != 0 )
+            if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
                 continue;
 
-            int unit2 = comp2->GetUnitSelection( &sheetList[i] );  // slow
+            // A suitable pin is found: add it to the current list
+            addPinToComponentPinList( comp2, sheet2, pin );
+        }
+    }
+}
 
-            for( LIB_PIN* pin = aEntry->GetNextPin();  pin;  pin = aEntry->GetNextPin( pin ) )
-            {
-                wxASSERT( pin->Type() == LIB_PIN_T );
 
-                if( pin->GetUnit() && pin->GetUnit() != unit2 )
-                    continue;
+const std::vector<std::pair<SCH_COMPONENT*, SCH_SHEET_PATH*>>&
+NETLIST_EXPORTER::getUnitsOfReference( const wxString& aRef )
+{
+    static const std::vector<std::pair<SCH_COMPONENT*, SCH_SHEET_PATH*>> empty;
 
-                if( pin->GetConvert() && pin->GetConvert() != comp2->GetConvert() )
-                    continue;
+    if( m_unitsByRef.empty() )
+    {
+        m_sheetList.BuildSheetList( g_RootSheet );
 
-                // A suitable pin is found: add it to the current list
-                addPinToComponentPinList( comp2, &sheetList[i], pin );
+        for( SCH_SHEET_PATH& sheet : m_sheetList )
+        {
+            for( auto item : sheet.LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
+            {
+                SCH_COMPONENT* comp = static_cast<SCH_COMPONENT*>( item );
+
+                m_unitsByRef[ comp->GetRef( &sheet ).Lower() ].emplace_back( comp, &sheet );
             }
         }
     }
-}
 
+    auto it = m_unitsByRef.find( aRef.Lower() );
+
+    return it != m_unitsByRef.end() ? it->second : empty;
+}
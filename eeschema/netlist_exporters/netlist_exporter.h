@@ -102,6 +102,17 @@ protected:
     /// unique library parts used. LIB_PART items are sorted by names
     std::set<LIB_PART*, LIB_PART_LESS_THAN> m_LibParts;
 
+    /// Pins of m_masterList keyed by parent component and pin number, in list order.
+    /// Built on first use by addPinToComponentPinList().  No ownership of members.
+    std::map<std::pair<SCH_ITEM*, wxString>, std::vector<NETLIST_OBJECT*>> m_pinIndex;
+
+    /// The sheets of the design, used by m_unitsByRef.
+    SCH_SHEET_LIST        m_sheetList;
+
+    /// Every component unit of the design keyed by its lower case reference designator,
+    /// in sheet then item order.  Built on first use by getUnitsOfReference().
+    std::map<wxString, std::vector<std::pair<SCH_COMPONENT*, SCH_SHEET_PATH*>>> m_unitsByRef;
+
     /**
      * Function sprintPinNetName
      * formats the net name for \a aPin using \a aNetNameFormat into \a aResult.
@@ -164,6 +175,15 @@ protected:
                                   LIB_PART*       aEntry,
                                   SCH_SHEET_PATH* aSheetPath );
 
+    /**
+     * Function getUnitsOfReference
+     * returns all the units (and their sheet paths) in the design whose reference designator
+     * matches \a aRef, ignoring case.  The lookup table is built once, on the first call, so
+     * callers no longer need to walk the whole sheet list for each multi-unit component.
+     */
+    const std::vector<std::pair<SCH_COMPONENT*, SCH_SHEET_PATH*>>&
+            getUnitsOfReference( const wxString& aRef );
+
 public:
 
     /**
@@ -80,6 +80,14 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeRoot( int aCtl )
 }
 
 
+/// A pin of a net, with the reference designator of its parent component resolved
+struct NET_NODE
+{
+    SCH_PIN* m_Pin;
+    wxString m_Ref;
+};
+
+
 /// Holder for multi-unit component fields
 struct COMP_FIELDS
 {
@@ -106,49 +114,40 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
 
         wxString    ref = comp->GetRef( aSheet );
 
-        SCH_SHEET_LIST sheetList( g_RootSheet );
         int minUnit = comp->GetUnit();
 
-        for( unsigned i = 0;  i < sheetList.size();  i++ )
+        for( const auto& unit2 : getUnitsOfReference( ref ) )
         {
-            for( auto item : sheetList[i].LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
-            {
-                SCH_COMPONENT*  comp2 = (SCH_COMPONENT*) item;
+            SCH_COMPONENT*  comp2 = unit2.first;
 
-                wxString ref2 = comp2->GetRef( &sheetList[i] );
+            int unit = comp2->GetUnit();
 
-                if( ref2.CmpNoCase( ref ) != 0 )
-                    continue;
+            // The lowest unit number wins.  User should only set fields in any one unit.
+            // remark: IsVoid() returns true for empty strings or the "~" string (empty field value)
+            if( !comp2->GetField( VALUE )->IsVoid()
+                    && ( unit < minUnit || fields.value.IsEmpty() ) )
+                fields.value = comp2->GetField( VALUE )->GetText();
 
-                int unit = comp2->GetUnit();
+            if( !comp2->GetField( FOOTPRINT )->IsVoid()
+                    && ( unit < minUnit || fields.footprint.IsEmpty() ) )
+                fields.footprint = comp2->GetField( FOOTPRINT )->GetText();
 
-                // The lowest unit number wins.  User should only set fields in any one unit.
-                // remark: IsVoid() returns true for empty strings or the "~" string (empty field value)
-                if( !comp2->GetField( VALUE )->IsVoid()
-                        && ( unit < minUnit || fields.value.IsEmpty() ) )
-                    fields.value = comp2->GetField( VALUE )->GetText();
+            if( !comp2->GetField( DATASHEET )->IsVoid()
+                    && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
+                fields.datasheet = comp2->GetField( DATASHEET )->GetText();
 
-                if( !comp2->GetField( FOOTPRINT )->IsVoid()
-                        && ( unit < minUnit || fields.footprint.IsEmpty() ) )
-                    fields.footprint = comp2->GetField( FOOTPRINT )->GetText();
-
-                if( !comp2->GetField( DATASHEET )->IsVoid()
-                        && ( unit < minUnit || fields.datasheet.IsEmpty() ) )
-                    fields.datasheet = comp2->GetField( DATASHEET )->GetText();
+            for( int fldNdx = MANDATORY_FIELDS;  fldNdx < comp2->GetFieldCount();  ++fldNdx )
+            {
+                SCH_FIELD* f = comp2->GetField( fldNdx );
 
-                for( int fldNdx = MANDATORY_FIELDS;  fldNdx < comp2->GetFieldCount();  ++fldNdx )
+                if( f->GetText().size()
+                    && ( unit < minUnit || fields.f.count( f->GetName() ) == 0 ) )
                 {
-                    SCH_FIELD* f = comp2->GetField( fldNdx );
-
-                    if( f->GetText().size()
-                        && ( unit < minUnit || fields.f.count( f->GetName() ) == 0 ) )
-                    {
-                        fields.f[ f->GetName() ] = f->GetText();
-                    }
+                    fields.f[ f->GetName() ] = f->GetText();
                 }
-
-                minUnit = std::min( unit, minUnit );
             }
+
+            minUnit = std::min( unit, minUnit );
         }
 
     }
@@ -534,47 +533,48 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
             code++;
 
             XNODE* xnode;
-            std::vector<std::pair<SCH_PIN*, SCH_SHEET_PATH>> sorted_items;
+            std::vector<NET_NODE> sorted_items;
 
             for( auto subgraph : subgraphs )
             {
-                auto sheet = subgraph->m_sheet;
+                SCH_SHEET_PATH* sheet = &subgraph->m_sheet;
 
                 for( auto item : subgraph->m_items )
+                {
                     if( item->Type() == SCH_PIN_T )
-                        sorted_items.emplace_back(
-                                std::make_pair( static_cast<SCH_PIN*>( item ), sheet ) );
+                    {
+                        SCH_PIN* pin = static_cast<SCH_PIN*>( item );
+
+                        // Resolve the reference once per pin rather than once per comparison
+                        sorted_items.push_back(
+                                { pin, pin->GetParentComponent()->GetRef( sheet ) } );
+                    }
+                }
             }
 
             // Netlist ordering: Net name, then ref des, then pin name
-            std::sort( sorted_items.begin(), sorted_items.end(), [] ( auto a, auto b ) {
-                        auto ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                        auto ref_b = b.first->GetParentComponent()->GetRef( &b.second );
-
-                        if( ref_a == ref_b )
-                            return a.first->GetNumber() < b.first->GetNumber();
+            std::sort( sorted_items.begin(), sorted_items.end(),
+                    [] ( const NET_NODE& a, const NET_NODE& b ) {
+                        if( a.m_Ref == b.m_Ref )
+                            return a.m_Pin->GetNumber() < b.m_Pin->GetNumber();
 
-                        return ref_a < ref_b;
+                        return a.m_Ref < b.m_Ref;
                     } );
 
             // Some duplicates can exist, for example on multi-unit parts with duplicated
             // pins across units.  If the user connects the pins on each unit, they will
             // appear on separate subgraphs.  Remove those here:
             sorted_items.erase( std::unique( sorted_items.begin(), sorted_items.end(),
-                    [] ( auto a, auto b ) {
-                        auto ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                        auto ref_b = b.first->GetParentComponent()->GetRef( &b.second );
-
-                        return ref_a == ref_b && a.first->GetNumber() == b.first->GetNumber();
+                    [] ( const NET_NODE& a, const NET_NODE& b ) {
+                        return a.m_Ref == b.m_Ref
+                                && a.m_Pin->GetNumber() == b.m_Pin->GetNumber();
                     } ), sorted_items.end() );
 
-            for( const auto& pair : sorted_items )
+            for( const NET_NODE& netNode : sorted_items )
             {
-                SCH_PIN* pin = pair.first;
-                SCH_SHEET_PATH sheet = pair.second;
-
-                auto refText = pin->GetParentComponent()->GetRef( &sheet );
-                const auto& pinText = pin->GetNumber();
+                SCH_PIN*        pin = netNode.m_Pin;
+                const wxString& refText = netNode.m_Ref;
+                const auto&     pinText = pin->GetNumber();
 
                 // Skip power symbols and virtual components
                 if( refText[0] == wxChar( '#' ) )
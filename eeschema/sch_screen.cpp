@@ -59,6 +59,7 @@
 #include <thread>
 #include <algorithm>
 #include <future>
+#include <unordered_map>
 
 // TODO(JE) Debugging only
 #include <profile.h>
@@ -769,18 +770,80 @@ void SCH_SCREEN::GetHierarchicalItems( EDA_ITEMS& aItems )
 }
 
 
-bool SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath )
+bool SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath,
+                                   std::function<void( SCH_ITEM* )>* aChangedHandler )
 {
-    std::vector< DANGLING_END_ITEM > endPoints;
-    bool hasStateChanged = false;
+    std::vector<DANGLING_END_ITEM> endPoints;
+    std::vector<size_t>            firstEndPoint;
+    bool                           hasStateChanged = false;
 
     for( SCH_ITEM* item : Items() )
+    {
+        firstEndPoint.push_back( endPoints.size() );
         item->GetEndPoints( endPoints );
+    }
+
+    firstEndPoint.push_back( endPoints.size() );
+
+    // Wires and pins only connect at coincident points, so index the end points by position
+    // and test those against the few end points sharing their positions rather than against
+    // every end point of the screen.  The index is rebuilt on each call because items are
+    // moved and rotated in place without the screen being told.
+    std::unordered_map<wxPoint, std::vector<size_t>> endPointsAt;
+
+    for( size_t ii = 0; ii < endPoints.size(); ++ii )
+        endPointsAt[ endPoints[ii].GetPosition() ].push_back( ii );
+
+    std::vector<size_t>            nearbyIdx;
+    std::vector<DANGLING_END_ITEM> nearby;
+    size_t                         itemIdx = 0;
 
     for( SCH_ITEM* item : Items() )
     {
-        if( item->UpdateDanglingState( endPoints, aPath ) )
+        size_t first = firstEndPoint[ itemIdx ];
+        size_t last  = firstEndPoint[ itemIdx + 1 ];
+        bool   changed;
+
+        itemIdx++;
+
+        switch( item->Type() )
+        {
+        case SCH_LINE_T:
+        case SCH_COMPONENT_T:
+            nearbyIdx.clear();
+
+            for( size_t ii = first; ii < last; ++ii )
+            {
+                const std::vector<size_t>& atPos = endPointsAt[ endPoints[ii].GetPosition() ];
+                nearbyIdx.insert( nearbyIdx.end(), atPos.begin(), atPos.end() );
+            }
+
+            // Keep the end points in screen order, once each
+            std::sort( nearbyIdx.begin(), nearbyIdx.end() );
+            nearbyIdx.erase( std::unique( nearbyIdx.begin(), nearbyIdx.end() ), nearbyIdx.end() );
+
+            nearby.clear();
+
+            for( size_t idx : nearbyIdx )
+                nearby.push_back( endPoints[idx] );
+
+            changed = item->UpdateDanglingState( nearby, aPath );
+            break;
+
+        default:
+            // Labels, sheet pins and bus entries can also connect to the middle of a wire,
+            // which the index can't answer, so they are tested against all the end points.
+            changed = item->UpdateDanglingState( endPoints, aPath );
+            break;
+        }
+
+        if( changed )
+        {
+            if( aChangedHandler )
+                ( *aChangedHandler )( item );
+
             hasStateChanged = true;
+        }
     }
 
     return hasStateChanged;
@@ -793,11 +856,8 @@ SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLay
     // an accuracy of 0 had problems with rounding errors; use at least 1
     aAccuracy = std::max( aAccuracy, 1 );
 
-    for( SCH_ITEM* item : Items() )
+    for( SCH_ITEM* item : Items().Overlapping( SCH_LINE_T, aPosition, aAccuracy ) )
     {
-        if( item->Type() != SCH_LINE_T )
-            continue;
-
         if( item->GetLayer() != aLayer )
             continue;
 
@@ -25,6 +25,7 @@
 #ifndef SCREEN_H
 #define SCREEN_H
 
+#include <functional>
 #include <memory>
 #include <stddef.h>
 #include <unordered_set>
@@ -284,9 +285,11 @@ public:
     /**
      * Test all of the connectable objects in the schematic for unused connection points.
      * @param aPath is a sheet path to pass to UpdateDanglingState if desired
+     * @param aChangedHandler an optional callback, called for each item whose state changed
      * @return True if any connection state changes were made.
      */
-    bool TestDanglingEnds( const SCH_SHEET_PATH* aPath = nullptr );
+    bool TestDanglingEnds( const SCH_SHEET_PATH* aPath = nullptr,
+                           std::function<void( SCH_ITEM* )>* aChangedHandler = nullptr );
 
     /**
      * Return all wires and junctions connected to \a aSegment which are not connected any
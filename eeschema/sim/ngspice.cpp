@@ -35,6 +35,7 @@
 #include <wx/stdpaths.h>
 #include <wx/dir.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -226,6 +227,53 @@ vector<double> NGSPICE::GetPhasePlot( const string& aName, int aMaxLen )
 }
 
 
+/**
+ * Returns the name used to match a vector requested in Spice convention (e.g. V(3), I(R1))
+ * with the names of the vectors sent by ngspice while it runs (e.g. 3, r1#branch).
+ */
+static string streamKey( const string& aName )
+{
+    string key( aName );
+
+    std::transform( key.begin(), key.end(), key.begin(), ::tolower );
+
+    if( key.size() > 3 && key[1] == '(' && key.back() == ')'
+            && key.find( ',' ) == string::npos )
+    {
+        if( key[0] == 'v' )
+            key = key.substr( 2, key.size() - 3 );
+        else if( key[0] == 'i' )
+            key = key.substr( 2, key.size() - 3 ) + "#branch";
+    }
+
+    return key;
+}
+
+
+void NGSPICE::SetStreamedVectors( const vector<string>& aNames )
+{
+    std::lock_guard<std::mutex> lock( m_streamLock );
+
+    m_streams.clear();
+    m_streamIndex.clear();
+
+    for( const string& name : aNames )
+        m_streams[ streamKey( name ) ];
+}
+
+
+vector<double> NGSPICE::GetStreamedMagPlot( const string& aName, size_t aStart )
+{
+    std::lock_guard<std::mutex> lock( m_streamLock );
+    auto it = m_streams.find( streamKey( aName ) );
+
+    if( it == m_streams.end() || aStart >= it->second.size() )
+        return vector<double>();
+
+    return vector<double>( it->second.begin() + aStart, it->second.end() );
+}
+
+
 bool NGSPICE::LoadNetlist( const string& aNetlist )
 {
     LOCALE_IO c_locale;       // ngspice works correctly only with C locale
@@ -389,7 +437,8 @@ void NGSPICE::init_dll()
     m_ngSpice_AllVecs = (ngSpice_AllVecs) m_dll.GetSymbol( "ngSpice_AllVecs" );
     m_ngSpice_Running = (ngSpice_Running) m_dll.GetSymbol( "ngSpice_running" ); // it is not a typo
 
-    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, NULL, NULL, &cbBGThreadRunning, this );
+    m_ngSpice_Init( &cbSendChar, &cbSendStat, &cbControlledExit, &cbSendData, &cbSendInitData,
+                    &cbBGThreadRunning, this );
 
     // Load a custom spinit file, to fix the problem with loading .cm files
     // Switch to the executable directory, so the relative paths are correct
@@ -551,6 +600,58 @@ int NGSPICE::cbBGThreadRunning( bool is_running, int id, void* user )
 }
 
 
+int NGSPICE::cbSendInitData( pvecinfoall vecs, int id, void* user )
+{
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    std::lock_guard<std::mutex> lock( sim->m_streamLock );
+
+    // A new run starts: drop the values of the previous one
+    for( auto& stream : sim->m_streams )
+        stream.second.clear();
+
+    sim->m_streamIndex.clear();
+
+    return 0;
+}
+
+
+int NGSPICE::cbSendData( pvecvaluesall vecs, int count, int id, void* user )
+{
+    NGSPICE* sim = reinterpret_cast<NGSPICE*>( user );
+    std::lock_guard<std::mutex> lock( sim->m_streamLock );
+
+    if( sim->m_streams.empty() )
+        return 0;
+
+    // The vectors are sent in the same order for the whole run, so look them up only once
+    if( (int) sim->m_streamIndex.size() != vecs->veccount )
+    {
+        sim->m_streamIndex.assign( vecs->veccount, nullptr );
+
+        for( int i = 0; i < vecs->veccount; i++ )
+        {
+            auto it = sim->m_streams.find( streamKey( vecs->vecsa[i]->name ) );
+
+            if( it != sim->m_streams.end() )
+                sim->m_streamIndex[i] = &it->second;
+        }
+    }
+
+    for( int i = 0; i < vecs->veccount; i++ )
+    {
+        if( vector<double>* stream = sim->m_streamIndex[i] )
+        {
+            const vecvalues* value = vecs->vecsa[i];
+
+            stream->push_back( value->is_complex ? hypot( value->creal, value->cimag )
+                                                 : value->creal );
+        }
+    }
+
+    return 0;
+}
+
+
 int NGSPICE::cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user )
 {
     // Something went wrong, reload the dll
@@ -30,6 +30,9 @@
 #include <wx/dynlib.h>
 #include <ngspice/sharedspice.h>
 
+#include <map>
+#include <mutex>
+
 class wxDynamicLibrary;
 
 class NGSPICE : public SPICE_SIMULATOR {
@@ -77,6 +80,12 @@ public:
     ///> @copydoc SPICE_SIMULATOR::GetPhasePlot()
     std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) override;
 
+    ///> @copydoc SPICE_SIMULATOR::SetStreamedVectors()
+    void SetStreamedVectors( const std::vector<std::string>& aNames ) override;
+
+    ///> @copydoc SPICE_SIMULATOR::GetStreamedMagPlot()
+    std::vector<double> GetStreamedMagPlot( const std::string& aName, size_t aStart ) override;
+
     ///> @copydoc SPICE_SIMULATOR::GetNetlist()
     virtual const std::string GetNetlist() const override;
 
@@ -123,6 +132,8 @@ private:
     static int cbSendChar( char* what, int id, void* user );
     static int cbSendStat( char* what, int id, void* user );
     static int cbBGThreadRunning( bool is_running, int id, void* user );
+    static int cbSendData( pvecvaluesall vecs, int count, int id, void* user );
+    static int cbSendInitData( pvecinfoall vecs, int id, void* user );
     static int cbControlledExit( int status, bool immediate, bool exit_upon_quit, int id, void* user );
 
     // Assures ngspice is in a valid state and reinitializes it if need be
@@ -136,6 +147,15 @@ private:
 
     ///> current netlist
     std::string m_netlist;
+
+    ///> Values of the streamed vectors recorded by the background thread, by streamKey()
+    std::map<std::string, std::vector<double>> m_streams;
+
+    ///> Streamed vector receiving each value sent by cbSendData(), or nullptr
+    std::vector<std::vector<double>*> m_streamIndex;
+
+    ///> Guards m_streams and m_streamIndex
+    std::mutex m_streamLock;
 };
 
 #endif /* NGSPICE_H */
@@ -120,6 +120,7 @@ wxString SIM_PLOT_FRAME::m_savedWorkbooksPath;
 SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
         : SIM_PLOT_FRAME_BASE( aParent ),
           m_lastSimPlot( nullptr ),
+          m_streamedPlot( nullptr ),
           m_welcomePanel( nullptr ),
           m_plotNumber( 0 )
 {
@@ -172,6 +173,9 @@ SIM_PLOT_FRAME::SIM_PLOT_FRAME( KIWAY* aKiway, wxWindow* aParent )
     Connect( EVT_SIM_FINISHED, wxCommandEventHandler( SIM_PLOT_FRAME::onSimFinished ), NULL, this );
     Connect( EVT_SIM_CURSOR_UPDATE, wxCommandEventHandler( SIM_PLOT_FRAME::onCursorUpdate ), NULL, this );
 
+    m_streamTimer.SetOwner( this );
+    Connect( wxEVT_TIMER, wxTimerEventHandler( SIM_PLOT_FRAME::onStreamTimer ), NULL, this );
+
     // Toolbar buttons
     m_toolSimulate = m_toolBar->AddTool( ID_SIM_RUN, _( "Run/Stop Simulation" ),
             KiBitmap( sim_run_xpm ), _( "Run Simulation" ), wxITEM_NORMAL );
@@ -458,6 +462,7 @@ void SIM_PLOT_FRAME::StartSimulation( const wxString& aSimCommand )
     m_simulator->LoadNetlist( formatter.GetString() );
     updateTuners();
     applyTuners();
+    setStreamedVectors();
     m_simulator->Run();
 }
 
@@ -1473,6 +1478,9 @@ void SIM_PLOT_FRAME::onSimStarted( wxCommandEvent& aEvent )
 {
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_stop_xpm ) );
     SetCursor( wxCURSOR_ARROWWAIT );
+
+    if( m_streamedPlot )
+        m_streamTimer.Start( 250 );
 }
 
 
@@ -1481,6 +1489,8 @@ void SIM_PLOT_FRAME::onSimFinished( wxCommandEvent& aEvent )
     m_toolBar->SetToolNormalBitmap( ID_SIM_RUN, KiBitmap( sim_run_xpm ) );
     SetCursor( wxCURSOR_ARROW );
 
+    m_streamTimer.Stop();
+
     SIM_TYPE simType = m_exporter->GetSimType();
 
     if( simType == ST_UNKNOWN )
@@ -1565,11 +1575,84 @@ void SIM_PLOT_FRAME::onSimUpdate( wxCommandEvent& aEvent )
         m_simConsole->Clear();
         // Do not export netlist, it is already stored in the simulator
         applyTuners();
+        setStreamedVectors();
         m_simulator->Run();
     }
 }
 
 
+void SIM_PLOT_FRAME::onStreamTimer( wxTimerEvent& aEvent )
+{
+    SIM_PLOT_PANEL* plotPanel = CurrentPlot();
+
+    // The streamed panel might have been closed or hidden in the meantime
+    if( !m_streamedPlot || plotPanel != m_streamedPlot )
+        return;
+
+    std::string xAxisName = m_simulator->GetXAxis( ST_TRANSIENT );
+
+    for( const auto& trace : m_plots[plotPanel].m_traces )
+    {
+        TRACE* plotTrace = plotPanel->GetTrace( trace.first );
+
+        if( !plotTrace )
+            continue;
+
+        const TRACE_DESC& desc = trace.second;
+        wxString spiceVector = m_exporter->ComponentToVector( desc.GetName(), desc.GetType(),
+                                                              desc.GetParam() );
+        size_t   start = plotTrace->GetDataX().size();
+
+        std::vector<double> data_x = m_simulator->GetStreamedMagPlot( xAxisName, start );
+        std::vector<double> data_y = m_simulator->GetStreamedMagPlot(
+                (const char*) spiceVector.c_str(), start );
+
+        // The simulation thread may have appended values in between the two calls
+        size_t size = std::min( data_x.size(), data_y.size() );
+
+        if( size == 0 )
+            continue;
+
+        data_x.resize( size );
+        data_y.resize( size );
+        plotPanel->AppendTraceData( trace.first, data_x, data_y );
+    }
+}
+
+
+void SIM_PLOT_FRAME::setStreamedVectors()
+{
+    SIM_PLOT_PANEL*          plotPanel = CurrentPlot();
+    std::vector<std::string> vectors;
+
+    m_streamedPlot = nullptr;
+
+    // Only transient analyses run long enough to be worth plotting while they run
+    if( plotPanel && plotPanel->GetType() == ST_TRANSIENT
+            && m_exporter->GetSimType() == ST_TRANSIENT )
+    {
+        vectors.push_back( m_simulator->GetXAxis( ST_TRANSIENT ) );
+
+        for( const auto& trace : m_plots[plotPanel].m_traces )
+        {
+            const TRACE_DESC& desc = trace.second;
+            wxString spiceVector = m_exporter->ComponentToVector( desc.GetName(), desc.GetType(),
+                                                                  desc.GetParam() );
+
+            vectors.push_back( (const char*) spiceVector.c_str() );
+
+            // The traces are filled again from the streamed values
+            if( TRACE* plotTrace = plotPanel->GetTrace( trace.first ) )
+                plotTrace->SetData( std::vector<double>(), std::vector<double>() );
+        }
+
+        m_streamedPlot = plotPanel;
+    }
+
+    m_simulator->SetStreamedVectors( vectors );
+}
+
+
 void SIM_PLOT_FRAME::onSimReport( wxCommandEvent& aEvent )
 {
     m_simConsole->AppendText( aEvent.GetString() + "\n" );
@@ -41,6 +41,7 @@
 #include <dialogs/dialog_sim_settings.h>
 
 #include <wx/event.h>
+#include <wx/timer.h>
 
 #include <list>
 #include <memory>
@@ -257,6 +258,13 @@ private:
      */
     void updateSignalList();
 
+    /**
+     * @brief Selects the vectors the simulator records while running, so the traces of the
+     * current transient plot are extended as the simulation goes. Must be called before the
+     * simulation is started.
+     */
+    void setStreamedVectors();
+
     /**
      * @brief Filters out tuners for components that do not exist anymore.
      * Decisions are based on the current NETLIST_EXPORTER data.
@@ -335,6 +343,7 @@ private:
     void onSimReport( wxCommandEvent& aEvent );
     void onSimStarted( wxCommandEvent& aEvent );
     void onSimFinished( wxCommandEvent& aEvent );
+    void onStreamTimer( wxTimerEvent& aEvent );
 
     // adjust the sash dimension of splitter windows after reading
     // the config settings
@@ -400,6 +409,12 @@ private:
     ///> Panel that was used as the most recent one for simulations
     SIM_PLOT_PANEL* m_lastSimPlot;
 
+    ///> Panel whose traces are extended while the simulation runs, or nullptr
+    SIM_PLOT_PANEL* m_streamedPlot;
+
+    ///> Fetches the values streamed by the running simulation
+    wxTimer m_streamTimer;
+
     ///> imagelists uset to add a small coloured icon to signal names
     ///> and cursors name, the same color as the corresponding signal traces
     wxImageList* m_signalsIconColorList;
@@ -263,6 +263,173 @@ public:
 };
 
 
+void TRACE::AppendData( const std::vector<double>& aX, const std::vector<double>& aY )
+{
+    wxCHECK_RET( aX.size() == aY.size(), "X and Y vectors are not of the same length" );
+
+    if( aX.empty() )
+        return;
+
+    if( m_cursor )
+        m_cursor->Update();
+
+    if( m_xs.empty() )
+    {
+        m_minX = m_maxX = aX[0];
+        m_minY = m_maxY = aY[0];
+    }
+
+    for( size_t i = 0; i < aX.size(); i++ )
+    {
+        m_minX = std::min( m_minX, aX[i] );
+        m_maxX = std::max( m_maxX, aX[i] );
+        m_minY = std::min( m_minY, aY[i] );
+        m_maxY = std::max( m_maxY, aY[i] );
+    }
+
+    m_xs.insert( m_xs.end(), aX.begin(), aX.end() );
+    m_ys.insert( m_ys.end(), aY.begin(), aY.end() );
+
+    updatePyramid();
+}
+
+
+void TRACE::updatePyramid()
+{
+    const size_t count = m_ys.size();
+
+    for( size_t i = std::max<size_t>( m_checkedCount, 1 ); i < count && m_increasingX; i++ )
+    {
+        if( m_xs[i] < m_xs[i - 1] )
+            m_increasingX = false;
+    }
+
+    m_checkedCount = count;
+
+    // Level n is needed as long as level n - 1 has more than one block
+    for( size_t level = 0, blockSize = 2; blockSize / 2 < count; level++, blockSize *= 2 )
+    {
+        if( m_pyramid.size() <= level )
+            m_pyramid.emplace_back();
+
+        std::vector<std::pair<size_t, size_t>>& blocks = m_pyramid[level];
+
+        // The last block might have been incomplete, so it is computed again
+        size_t first = blocks.empty() ? 0 : blocks.size() - 1;
+        blocks.resize( ( count + blockSize - 1 ) / blockSize );
+
+        for( size_t b = first; b < blocks.size(); b++ )
+        {
+            std::pair<size_t, size_t> left, right;
+
+            if( level == 0 )
+            {
+                left = std::make_pair( 2 * b, 2 * b );
+                right = 2 * b + 1 < count ? std::make_pair( 2 * b + 1, 2 * b + 1 ) : left;
+            }
+            else
+            {
+                const std::vector<std::pair<size_t, size_t>>& below = m_pyramid[level - 1];
+
+                left = below[2 * b];
+                right = 2 * b + 1 < below.size() ? below[2 * b + 1] : left;
+            }
+
+            blocks[b].first = m_ys[right.first] < m_ys[left.first] ? right.first : left.first;
+            blocks[b].second = m_ys[right.second] > m_ys[left.second] ? right.second
+                                                                         : left.second;
+        }
+    }
+}
+
+
+void TRACE::Plot( wxDC& aDC, mpWindow& aWindow )
+{
+    if( !m_continuous || !m_increasingX || m_xs.size() < 2 )
+    {
+        mpFXYVector::Plot( aDC, aWindow );
+        return;
+    }
+
+    if( m_visible )
+    {
+        aDC.SetPen( m_pen );
+
+        wxCoord startPx = m_drawOutsideMargins ? 0 : aWindow.GetMarginLeft();
+        wxCoord endPx   = m_drawOutsideMargins ? aWindow.GetScrX()
+                                               : aWindow.GetScrX() - aWindow.GetMarginRight();
+        wxCoord minYpx  = m_drawOutsideMargins ? 0 : aWindow.GetMarginTop();
+        wxCoord maxYpx  = m_drawOutsideMargins ? aWindow.GetScrY()
+                                               : aWindow.GetScrY() - aWindow.GetMarginBottom();
+
+        aDC.SetClippingRegion( startPx, minYpx, endPx - startPx + 1, maxYpx - minYpx + 1 );
+
+        // Range of the visible points, plus one point on each side to reach the plot edges
+        double minX = s2x( aWindow.p2x( startPx ) );
+        double maxX = s2x( aWindow.p2x( endPx ) );
+        size_t first = std::lower_bound( m_xs.begin(), m_xs.end(), minX ) - m_xs.begin();
+        size_t last = std::upper_bound( m_xs.begin(), m_xs.end(), maxX ) - m_xs.begin();
+
+        first = first > 0 ? first - 1 : 0;
+        last = std::min( last, m_xs.size() - 1 );
+
+        if( last < first )
+            last = first;
+
+        // Use the coarsest level still giving at least one block per pixel column
+        const size_t visible = last - first + 1;
+        const size_t width = std::max( endPx - startPx, 1 );
+        int          level = -1;
+        size_t       blockSize = 1;
+
+        while( level + 1 < (int) m_pyramid.size() && visible / ( blockSize * 2 ) >= width )
+        {
+            level++;
+            blockSize *= 2;
+        }
+
+        std::vector<wxPoint> points;
+
+        auto addPoint = [&]( size_t aIndex )
+        {
+            points.emplace_back( aWindow.x2p( x2s( m_xs[aIndex] ) ),
+                                 aWindow.y2p( y2s( m_ys[aIndex] ) ) );
+        };
+
+        if( level < 0 )
+        {
+            points.reserve( visible );
+
+            for( size_t i = first; i <= last; i++ )
+                addPoint( i );
+        }
+        else
+        {
+            const std::vector<std::pair<size_t, size_t>>& blocks = m_pyramid[level];
+
+            points.reserve( 2 * ( last / blockSize - first / blockSize + 1 ) );
+
+            // Draw the lowest and the highest point of each block, in their X order
+            for( size_t b = first / blockSize; b <= last / blockSize; b++ )
+            {
+                size_t lo = std::min( blocks[b].first, blocks[b].second );
+                size_t hi = std::max( blocks[b].first, blocks[b].second );
+
+                addPoint( lo );
+
+                if( hi != lo )
+                    addPoint( hi );
+            }
+        }
+
+        if( points.size() > 1 )
+            aDC.DrawLines( points.size(), points.data() );
+    }
+
+    aDC.DestroyClippingRegion();
+}
+
+
 void CURSOR::Plot( wxDC& aDC, mpWindow& aWindow )
 {
     if( !m_window )
@@ -562,6 +729,21 @@ bool SIM_PLOT_PANEL::AddTrace( const wxString& aName, int aPoints,
 }
 
 
+bool SIM_PLOT_PANEL::AppendTraceData( const wxString& aName, const std::vector<double>& aX,
+                                      const std::vector<double>& aY )
+{
+    TRACE* trace = GetTrace( aName );
+
+    if( !trace )
+        return false;
+
+    trace->AppendData( aX, aY );
+    m_plotWin->UpdateAll();
+
+    return true;
+}
+
+
 bool SIM_PLOT_PANEL::DeleteTrace( const wxString& aName )
 {
     auto it = m_traces.find( aName );
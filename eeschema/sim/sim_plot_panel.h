@@ -93,7 +93,8 @@ class TRACE : public mpFXYVector
 {
 public:
     TRACE( const wxString& aName ) :
-        mpFXYVector( aName ), m_cursor( nullptr ), m_flags( 0 )
+        mpFXYVector( aName ), m_cursor( nullptr ), m_flags( 0 ), m_checkedCount( 0 ),
+        m_increasingX( true )
     {
         SetContinuity( true );
         SetDrawOutsideMargins( false );
@@ -111,8 +112,28 @@ public:
             m_cursor->Update();
 
         mpFXYVector::SetData( aX, aY );
+
+        m_pyramid.clear();
+        m_checkedCount = 0;
+        m_increasingX = true;
+        updatePyramid();
     }
 
+    /**
+     * @brief Appends points to the trace, e.g. values streamed by a running simulation.
+     * aX and aY need to have the same length.
+     * @param aX are the X axis values.
+     * @param aY are the Y axis values.
+     */
+    void AppendData( const std::vector<double>& aX, const std::vector<double>& aY );
+
+    /**
+     * @brief Plots the trace. Continuous traces with increasing X values are drawn from
+     * a min/max decimation pyramid, so the cost depends on the plot width rather than on
+     * the number of points.
+     */
+    void Plot( wxDC& aDC, mpWindow& aWindow ) override;
+
     const std::vector<double>& GetDataX() const
     {
         return m_xs;
@@ -159,9 +180,20 @@ public:
     }
 
 protected:
+    ///> Extends the decimation pyramid to the current number of points
+    void updatePyramid();
+
     CURSOR* m_cursor;
     int m_flags;
     wxColour m_traceColour;
+
+    ///> Decimation pyramid: level n holds the indices of the points with the lowest and
+    ///> the highest Y value in each block of 2^(n+1) points
+    std::vector<std::vector<std::pair<size_t, size_t>>> m_pyramid;
+
+    ///> Number of points whose X value was checked to be increasing
+    size_t m_checkedCount;
+    bool m_increasingX;
 };
 
 
@@ -198,6 +230,13 @@ public:
     bool AddTrace( const wxString& aName, int aPoints,
             const double* aX, const double* aY, SIM_PLOT_TYPE aFlags );
 
+    /**
+     * @brief Appends points to an existing trace, e.g. values streamed by a running simulation.
+     * @return False if there is no trace with the given name.
+     */
+    bool AppendTraceData( const wxString& aName, const std::vector<double>& aX,
+                          const std::vector<double>& aY );
+
     bool DeleteTrace( const wxString& aName );
 
     void DeleteAllTraces();
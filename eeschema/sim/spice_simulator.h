@@ -145,6 +145,27 @@ public:
      */
     virtual std::vector<double> GetPhasePlot( const std::string& aName, int aMaxLen = -1 ) = 0;
 
+    /**
+     * @brief Selects the vectors recorded while the simulation runs in the background, so
+     * they can be plotted before it finishes. Values recorded by a previous run are dropped.
+     * @param aNames are the vectors named in Spice convention (e.g. V(3), I(R1)), including
+     * the x axis vector. An empty list disables recording.
+     */
+    virtual void SetStreamedVectors( const std::vector<std::string>& aNames ) {}
+
+    /**
+     * @brief Returns the magnitude values of a vector recorded by the running simulation.
+     * Unlike the other methods, it can be called while the simulation is running.
+     * @param aName is the vector name, as passed to SetStreamedVectors().
+     * @param aStart is the index of the first value to return, so only new values are copied.
+     * @return Values recorded from aStart on. It might be empty if there are no new values or
+     * the vector is not recorded.
+     */
+    virtual std::vector<double> GetStreamedMagPlot( const std::string& aName, size_t aStart )
+    {
+        return std::vector<double>();
+    }
+
     /**
      * @brief Returns current SPICE netlist used by the simulator.
      * @return The netlist.
@@ -554,6 +554,7 @@ void EE_POINT_EDITOR::updateItem() const
         double heightRatio = newHeight / oldHeight;
 
         bitmap->SetImageScale( bitmap->GetImageScale() * std::min( widthRatio, heightRatio ) );
+        m_frame->GetScreen()->Update( bitmap );
         break;
     }
 
@@ -596,6 +597,7 @@ void EE_POINT_EDITOR::updateItem() const
             pin->SetPosition( pos );
         }
 
+        m_frame->GetScreen()->Update( sheet );
         break;
     }
 
@@ -606,6 +608,9 @@ void EE_POINT_EDITOR::updateItem() const
         line->SetStartPoint( (wxPoint) m_editPoints->Point( LINE_START ).GetPosition() );
         line->SetEndPoint( (wxPoint) m_editPoints->Point( LINE_END ).GetPosition() );
 
+        // The screen looks up wires by position in its R-tree (see SCH_SCREEN::GetLine())
+        m_frame->GetScreen()->Update( line );
+
         SCH_LINE* connection = (SCH_LINE*) ( m_editPoints->Point( LINE_START ).GetConnection() );
 
         if( connection )
@@ -615,6 +620,7 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetPosition() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
@@ -627,6 +633,7 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetEndPoint() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
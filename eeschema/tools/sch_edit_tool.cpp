@@ -372,6 +372,27 @@ const KICAD_T rotatableItems[] = {
 };
 
 
+void SCH_EDIT_TOOL::updateRTree( SCH_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    // Sheet pins stay on the edges of their sheet, which does not change its BBox.
+    case SCH_SHEET_PIN_T:
+        break;
+
+    // Fields are part of the BBox of their parent
+    case SCH_FIELD_T:
+        if( aItem->GetParent() )
+            m_frame->GetScreen()->Update( static_cast<SCH_ITEM*>( aItem->GetParent() ) );
+
+        break;
+
+    default:
+        m_frame->GetScreen()->Update( aItem );
+    }
+}
+
+
 int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
 {
     EE_SELECTION& selection = m_selectionTool->RequestSelection( rotatableItems );
@@ -484,6 +505,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
         }
 
         connections = item->IsConnectable();
+        updateRTree( item );
         m_frame->RefreshItem( item );
     }
     else if( selection.GetSize() > 1 )
@@ -531,6 +553,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
             }
 
             connections |= item->IsConnectable();
+            updateRTree( item );
             m_frame->RefreshItem( item );
         }
     }
@@ -668,6 +691,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
         }
 
         connections = item->IsConnectable();
+        updateRTree( item );
         m_frame->RefreshItem( item );
     }
     else if( selection.GetSize() > 1 )
@@ -708,6 +732,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
             }
 
             connections |= item->IsConnectable();
+            updateRTree( item );
             m_frame->RefreshItem( item );
         }
     }
@@ -71,6 +71,9 @@ public:
 private:
     void editFieldText( SCH_FIELD* aField );
 
+    ///> Updates the screen's R-tree for an item rotated or mirrored in place.
+    void updateRTree( SCH_ITEM* aItem );
+
     ///> Sets up handlers for various events.
     void setTransitions() override;
 
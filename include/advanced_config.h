@@ -24,6 +24,8 @@
 #ifndef ADVANCED_CFG__H
 #define ADVANCED_CFG__H
 
+#include <wx/string.h>
+
 class wxConfigBase;
 
 /**
@@ -83,6 +85,12 @@ public:
      */
     int m_coroutineStackSize;
 
+    /**
+     * File the interactive router saves its sessions to after each routing or dragging
+     * operation, for replaying them with qa_pcbnew_tools.  Empty disables the recording.
+     */
+    wxString m_RouterSessionLog;
+
 
 private:
     ADVANCED_CFG();
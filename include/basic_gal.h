@@ -25,6 +25,8 @@
 #ifndef BASIC_GAL_H
 #define BASIC_GAL_H
 
+#include <mutex>
+
 #include <eda_rect.h>
 
 #include <gal/stroke_font.h>
@@ -117,6 +119,7 @@ public:
      * @param aPointList is a list of 2D-Vectors containing the polyline points.
      */
     virtual void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
+    virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
 
     /** Start and end points are defined as 2D-Vectors.
      * @param aStartPoint   is the start point of the line.
@@ -149,6 +152,9 @@ private:
     // Apply the roation/translation transform to aPoint
     const VECTOR2D transform( const VECTOR2D& aPoint ) const;
 
+    // Draw a polyline whose corners are already transformed
+    void doDrawPolyline( const std::vector<wxPoint>& aLocalPointList );
+
     // A clip box, to clip drawings in a wxDC (mandatory to avoid draw issues)
     EDA_RECT  m_clipBox;        // The clip box
     bool      m_isClipped;      // Allows/disallows clipping
@@ -167,4 +173,8 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+/// basic_gal holds the current text attributes and output, so it must be locked by users
+/// that can run in a thread (like plotting several layers at once)
+extern std::mutex basic_gal_mutex;
+
 #endif      // define BASIC_GAL_H
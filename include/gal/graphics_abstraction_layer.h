@@ -28,6 +28,7 @@
 #define GRAPHICSABSTRACTIONLAYER_H_
 
 #include <deque>
+#include <vector>
 #include <stack>
 #include <limits>
 
@@ -63,6 +64,7 @@ class GAL : GAL_DISPLAY_OPTIONS_OBSERVER
     friend class GAL_CONTEXT_LOCKER;
     friend class GAL_UPDATE_CONTEXT;
     friend class GAL_DRAWING_CONTEXT;
+    friend class RECORDING_GAL;
 
 public:
     // Constructor / Destructor
@@ -115,6 +117,21 @@ public:
     virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) {};
     virtual void DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain ) {};
 
+    /**
+     * @brief Draw a set of polylines sharing the current stroke settings (e.g. the strokes of
+     * a text string).  Implementations may emit them as a single batch.
+     *
+     * @param aPointLists is the list of polylines, each one a list of 2D-Vectors.
+     */
+    virtual void DrawPolylines( const std::vector<std::vector<VECTOR2D>>& aPointLists )
+    {
+        for( const std::vector<VECTOR2D>& points : aPointLists )
+        {
+            if( !points.empty() )
+                DrawPolyline( points.data(), points.size() );
+        }
+    }
+
     /**
      * @brief Draw a circle using world coordinates.
      *
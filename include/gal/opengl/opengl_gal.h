@@ -131,6 +131,9 @@ public:
     virtual void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
     virtual void DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain ) override;
 
+    /// @copydoc GAL::DrawPolylines()
+    virtual void DrawPolylines( const std::vector<std::vector<VECTOR2D>>& aPointLists ) override;
+
     /// @copydoc GAL::DrawPolygon()
     virtual void DrawPolygon( const std::deque<VECTOR2D>& aPointList ) override;
     virtual void DrawPolygon( const VECTOR2D aPointList[], int aListSize ) override;
@@ -354,8 +357,10 @@ private:
      *
      * @param aStartPoint is the start point of the line.
      * @param aEndPoint is the end point of the line.
+     * @param aReserve when false, the 6 vertices must have been reserved by the caller.
      */
-    void drawLineQuad( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint );
+    void drawLineQuad( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                       bool aReserve = true );
 
     /**
      * @brief Draw a semicircle. Depending on settings (isStrokeEnabled & isFilledEnabled) it runs
@@ -0,0 +1,132 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef RECORDING_GAL_H_
+#define RECORDING_GAL_H_
+
+#include <functional>
+#include <vector>
+
+#include <gal/graphics_abstraction_layer.h>
+
+namespace KIGFX
+{
+
+/**
+ * RECORDING_GAL stores drawing commands instead of executing them.
+ *
+ * It lets painters run on worker threads (the real GAL owns a graphics context and may only
+ * be used from the main thread).  The recorder mirrors the view state of the target GAL
+ * (transformations, flipping, engine type), so painters compute the same geometry they
+ * would compute when drawing directly.  Stroke text is laid out by the recorder itself,
+ * so only the resulting line strokes are stored.
+ *
+ * The recorded commands are later executed on the target GAL with Replay().
+ */
+class RECORDING_GAL : public GAL
+{
+public:
+    typedef std::function<void( GAL& )> COMMAND;
+
+    /**
+     * @param aTarget is the GAL that will replay the commands.  Its view state is copied,
+     * so the recorder has to be recreated (or SyncWith() called) when the view changes.
+     */
+    RECORDING_GAL( GAL* aTarget );
+
+    /// Copies the view state (matrices, zoom, flipping, engine type) of a GAL.
+    void SyncWith( GAL* aTarget );
+
+    bool IsCairoEngine() override { return m_isCairo; }
+    bool IsOpenGlEngine() override { return m_isOpenGl; }
+
+    // Drawing methods
+    void DrawLine( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+    void DrawSegment( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint,
+                      double aWidth ) override;
+    void DrawPolyline( const std::deque<VECTOR2D>& aPointList ) override;
+    void DrawPolyline( const VECTOR2D aPointList[], int aListSize ) override;
+    void DrawPolyline( const SHAPE_LINE_CHAIN& aLineChain ) override;
+    void DrawPolylines( const std::vector<std::vector<VECTOR2D>>& aPointLists ) override;
+    void DrawCircle( const VECTOR2D& aCenterPoint, double aRadius ) override;
+    void DrawArc( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                  double aEndAngle ) override;
+    void DrawArcSegment( const VECTOR2D& aCenterPoint, double aRadius, double aStartAngle,
+                         double aEndAngle, double aWidth ) override;
+    void DrawRectangle( const VECTOR2D& aStartPoint, const VECTOR2D& aEndPoint ) override;
+    void DrawPolygon( const std::deque<VECTOR2D>& aPointList ) override;
+    void DrawPolygon( const VECTOR2D aPointList[], int aListSize ) override;
+    void DrawPolygon( const SHAPE_POLY_SET& aPolySet ) override;
+    void DrawPolygon( const SHAPE_LINE_CHAIN& aPolySet ) override;
+    void DrawCurve( const VECTOR2D& startPoint, const VECTOR2D& controlPointA,
+                    const VECTOR2D& controlPointB, const VECTOR2D& endPoint,
+                    double aFilterValue = 0.0 ) override;
+    void DrawBitmap( const BITMAP_BASE& aBitmap ) override;
+
+    // Attribute setting methods
+    void SetIsFill( bool aIsFillEnabled ) override;
+    void SetIsStroke( bool aIsStrokeEnabled ) override;
+    void SetFillColor( const COLOR4D& aColor ) override;
+    void SetStrokeColor( const COLOR4D& aColor ) override;
+    void SetLineWidth( float aLineWidth ) override;
+    void SetLayerDepth( double aLayerDepth ) override;
+    void SetNegativeDrawMode( bool aSetting ) override;
+
+    // Text
+    void BitmapText( const wxString& aText, const VECTOR2D& aPosition,
+                     double aRotationAngle ) override;
+
+    // Transformation
+    void Transform( const MATRIX3x3D& aTransformation ) override;
+    void Rotate( double aAngle ) override;
+    void Translate( const VECTOR2D& aTranslation ) override;
+    void Scale( const VECTOR2D& aScale ) override;
+    void Save() override;
+    void Restore() override;
+
+    /// Returns true if no commands were recorded since the last Clear().
+    bool Empty() const { return m_commands.empty(); }
+
+    /// Drops the recorded commands.
+    void Clear() { m_commands.clear(); }
+
+    /// Moves the recorded commands out of the recorder, leaving it empty.
+    std::vector<COMMAND> TakeCommands();
+
+    /// Executes a list of recorded commands on a GAL.
+    static void Replay( const std::vector<COMMAND>& aCommands, GAL* aGal );
+
+private:
+    void record( COMMAND&& aCommand )
+    {
+        m_commands.emplace_back( std::move( aCommand ) );
+    }
+
+    std::vector<COMMAND> m_commands;
+    bool                 m_isCairo;
+    bool                 m_isOpenGl;
+};
+
+} // namespace KIGFX
+
+#endif /* RECORDING_GAL_H_ */
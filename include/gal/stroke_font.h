@@ -30,6 +30,7 @@
 #define STROKE_FONT_H_
 
 #include <deque>
+#include <vector>
 #include <algorithm>
 
 #include <utf8.h>
@@ -118,6 +119,9 @@ private:
     const GLYPH_LIST*         m_glyphs;               ///< Glyph list
     const std::vector<BOX2D>* m_glyphBoundingBoxes;   ///< Bounding boxes of the glyphs
 
+    ///> Strokes of the line being drawn, kept to reuse their storage from one text to the next
+    std::vector<std::vector<VECTOR2D>> m_strokeBuffer;
+
     /**
      * @brief Compute the X and Y size of a given text. The text is expected to be
      * a only one line text.
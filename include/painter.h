@@ -104,6 +104,28 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Function CanClone
+     * @return true if Clone() is supported by this painter.
+     */
+    virtual bool CanClone() const
+    {
+        return false;
+    }
+
+    /**
+     * Function Clone
+     * Creates an independent painter with the same settings, drawing on another GAL.
+     * Painters that can be cloned may be used to draw items from several threads at once,
+     * each thread using its own clone.
+     * @param aGal is the GAL used by the new painter.
+     * @return the new painter (owned by the caller) or nullptr if CanClone() is false.
+     */
+    virtual PAINTER* Clone( GAL* aGal ) const
+    {
+        return nullptr;
+    }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
@@ -32,6 +32,7 @@
 #ifndef PLOT_COMMON_H_
 #define PLOT_COMMON_H_
 
+#include <unordered_map>
 #include <vector>
 #include <math/box2.h>
 #include <gr_text.h>
@@ -1270,6 +1271,15 @@ public:
     void PlotGerberRegion( const std::vector< wxPoint >& aCornerList,
                            void * aData = NULL );
 
+    /**
+     * Plot a set of filled polygons as one Gerber region statement (one G36/G37 sequence,
+     * one contour per polygon).  The result is the same as calling PlotPoly( FILLED_SHAPE )
+     * for each polygon, but the file is smaller and faster to write and to read.
+     * aData is used as in PlotPoly(): only its net attributes are used.
+     */
+    void PlotPolyRegions( const std::vector< std::vector< wxPoint > >& aContours,
+                          void* aData = NULL );
+
     /**
      * Change the plot polarity and begin a new layer
      * Used to 'scratch off' silk screen away from solder mask
@@ -1410,6 +1420,28 @@ protected:
     std::vector<APERTURE> m_apertures; // The list of available apertures
     int     m_currentApertureIdx;      // The index of the current aperture in m_apertures
 
+    // The index in m_apertures of each aperture, from its type, size and attribute,
+    // to find an existing aperture without searching the whole list
+    struct APERTURE_KEY
+    {
+        int    m_Type;
+        wxSize m_Size;
+        int    m_ApertureAttribute;
+
+        bool operator==( const APERTURE_KEY& aOther ) const
+        {
+            return m_Type == aOther.m_Type && m_Size == aOther.m_Size
+                   && m_ApertureAttribute == aOther.m_ApertureAttribute;
+        }
+    };
+
+    struct APERTURE_KEY_HASH
+    {
+        size_t operator()( const APERTURE_KEY& aKey ) const;
+    };
+
+    std::unordered_map<APERTURE_KEY, int, APERTURE_KEY_HASH> m_apertureIndex;
+
     bool    m_gerberUnitInch;          // true if the gerber units are inches, false for mm
     int     m_gerberUnitFmt;           // number of digits in mantissa.
                                        // usually 6 in Inches and 5 or 6  in mm
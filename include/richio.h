@@ -396,6 +396,19 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Function PrintRaw
+     * writes \a aText as is to the output stream, without formatting it.  Used to output text
+     * already formatted by another OUTPUTFORMATTER.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void PrintRaw( const std::string& aText )
+    {
+        if( !aText.empty() )
+            write( aText.data(), (int) aText.size() );
+    }
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination.
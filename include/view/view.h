@@ -29,6 +29,7 @@
 #include <set>
 #include <unordered_map>
 #include <memory>
+#include <functional>
 
 #include <math/box2.h>
 #include <gal/definitions.h>
@@ -781,14 +782,29 @@ protected:
      * Manages dirty flags & redraw queueing when updating an item.
      * @param aItem is the item to be updated.
      * @param aUpdateFlags determines the way an item is refreshed.
+     * @param aDeferredLayers if not null, cached layers that need their geometry redrawn
+     * are stored there instead of being redrawn immediately.
      */
-    void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags );
+    void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags,
+                         std::vector<int>* aDeferredLayers = nullptr );
 
     /// Updates colors that are used for an item to be drawn
     void updateItemColor( VIEW_ITEM* aItem, int aLayer );
 
-    /// Updates all informations needed to draw an item
-    void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
+    /**
+     * Updates all informations needed to draw an item.
+     * @param aRecorded are drawing commands prepared in advance (see RECORDING_GAL).  If null,
+     * the item is drawn using the painter.
+     */
+    void updateItemGeometry( VIEW_ITEM* aItem, int aLayer,
+                             const std::vector<std::function<void( GAL& )>>* aRecorded = nullptr );
+
+    /**
+     * Redraws geometry of many items at once.  Drawing commands are recorded by clones of
+     * the painter on worker threads and then replayed on the GAL by the calling thread.
+     * @param aItems are the items with pending updates.
+     */
+    void updateItemsParallel( const std::vector<VIEW_ITEM*>& aItems );
 
     /// Updates bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
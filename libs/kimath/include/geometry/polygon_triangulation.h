@@ -661,6 +661,9 @@ public:
         m_bbox = aPoly.BBox();
         m_result.Clear();
 
+        // A simple polygon of n vertices gives n - 2 triangles
+        m_result.Reserve( aPoly.PointCount(), std::max( aPoly.PointCount() - 2, 0 ) );
+
         if( !m_bbox.GetWidth() || !m_bbox.GetHeight() )
             return false;
 
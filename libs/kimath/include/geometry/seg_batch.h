@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __SEG_BATCH_H
+#define __SEG_BATCH_H
+
+#include <climits>
+#include <cmath>
+
+#include <geometry/seg.h>
+#include <math/vector2d.h>
+
+class SHAPE_LINE_CHAIN;
+
+/**
+ * SEG_BATCH
+ *
+ * The segments of a line chain, tested many at once against one segment or point.
+ *
+ * The bounding boxes of the segments are first compared with the query in blocks, in a loop
+ * the compiler turns into SIMD instructions (AVX2 is selected at run time when available).
+ * Only the segments which pass this test are handed to the scalar SEG code, so the results are
+ * exactly the ones of testing every segment in order with SEG::Collide(), SEG::SquaredDistance()
+ * or SEG::Intersect().
+ *
+ * The batch reads the points of the chain in place, so it is cheap enough to be built for a
+ * single query, but it must not be used once the chain has been modified or destroyed.
+ */
+class SEG_BATCH
+{
+public:
+    SEG_BATCH()
+    {}
+
+    explicit SEG_BATCH( const SHAPE_LINE_CHAIN& aChain );
+
+    int SegmentCount() const
+    {
+        return m_count;
+    }
+
+    /**
+     * @return segment aIndex, the same as SHAPE_LINE_CHAIN::CSegment( aIndex ) of the chain.
+     */
+    SEG Segment( int aIndex ) const
+    {
+        // The closing segment of a closed chain ends on the first point
+        const VECTOR2I& b = aIndex + 1 < m_pointCount ? m_points[aIndex + 1] : m_points[0];
+
+        return SEG( m_points[aIndex], b, aIndex );
+    }
+
+    /**
+     * Function Collide()
+     *
+     * @return the index of the first segment which collides with aSeg (see SEG::Collide()),
+     * or -1 if none does.
+     */
+    int Collide( const SEG& aSeg, int aClearance ) const;
+
+    /**
+     * Function Collide()
+     *
+     * @return the index of the first segment closer than aClearance to aP, or -1 if none is.
+     */
+    int Collide( const VECTOR2I& aP, int aClearance ) const
+    {
+        return Collide( SEG( aP, aP ), aClearance );
+    }
+
+    /**
+     * Function SquaredDistance()
+     *
+     * @param aIndex is set to the index of the (first) closest segment, if not null.
+     * @return the smallest SEG::SquaredDistance() of the segments to aP, or
+     * VECTOR2I::ECOORD_MAX if the batch is empty.
+     */
+    SEG::ecoord SquaredDistance( const VECTOR2I& aP, int* aIndex = nullptr ) const;
+
+    /**
+     * Function SquaredDistance()
+     *
+     * @param aIndex is set to the index of the (first) closest segment, if not null.
+     * @return the smallest SEG::SquaredDistance() of the segments to aSeg, or
+     * VECTOR2I::ECOORD_MAX if the batch is empty.
+     */
+    SEG::ecoord SquaredDistance( const SEG& aSeg, int* aIndex = nullptr ) const;
+
+    /**
+     * Function Distance()
+     *
+     * @return the smallest SEG::Distance() of the segments to aP, or INT_MAX if the batch
+     * is empty.
+     */
+    int Distance( const VECTOR2I& aP ) const
+    {
+        return m_count ? (int) std::sqrt( (double) SquaredDistance( aP ) ) : INT_MAX;
+    }
+
+    /**
+     * Function Distance()
+     *
+     * @return the smallest SEG::Distance() of the segments to aSeg, or INT_MAX if the batch
+     * is empty.
+     */
+    int Distance( const SEG& aSeg ) const
+    {
+        return m_count ? (int) std::sqrt( (double) SquaredDistance( aSeg ) ) : INT_MAX;
+    }
+
+    /**
+     * Function Intersect()
+     *
+     * @param aIndex is set to the index of the intersecting segment, if not null.
+     * @return the intersection of aSeg with the first segment which crosses it, if any.
+     */
+    OPT_VECTOR2I Intersect( const SEG& aSeg, int* aIndex = nullptr ) const;
+
+private:
+    ///> Points of the chain, segment i goes from point i to point i + 1 (or to the first point
+    ///> for the closing segment of a closed chain).
+    const VECTOR2I* m_points = nullptr;
+    int             m_pointCount = 0;
+    int             m_count = 0;
+};
+
+#endif // __SEG_BATCH_H
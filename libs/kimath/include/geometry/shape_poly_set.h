@@ -26,6 +26,7 @@
 #ifndef __SHAPE_POLY_SET_H
 #define __SHAPE_POLY_SET_H
 
+#include <atomic>
 #include <cstdio>
 #include <deque>                        // for deque
 #include <iosfwd>                       // for string, stringstream
@@ -58,7 +59,13 @@
  *      outline or a hole.
  *      - Vertex (or corner): each one of the points that define a contour.
  *
- * TODO: add convex partitioning & spatial index
+ * Large polygons get an edge index once the set has been queried a few times, which is used
+ * by the collision, distance and containment queries.  It is dropped by any modification of
+ * the set.  Once a non-const reference to its contours, polygons or vertices has been given
+ * out, the index is checked against the checksum of the polygons on the next query, so such
+ * a reference must not be used to modify the set after that query.
+ *
+ * TODO: add convex partitioning
  */
 class SHAPE_POLY_SET : public SHAPE
 {
@@ -86,6 +93,12 @@ class SHAPE_POLY_SET : public SHAPE
                 m_triangles.clear();
             }
 
+            void Reserve( size_t aVertexCount, size_t aTriangleCount )
+            {
+                m_vertices.reserve( aVertexCount );
+                m_triangles.reserve( aTriangleCount );
+            }
+
             void GetTriangle( int index, VECTOR2I& a, VECTOR2I& b, VECTOR2I& c ) const
             {
                 auto tri = m_triangles[ index ];
@@ -119,10 +132,15 @@ class SHAPE_POLY_SET : public SHAPE
                 return m_vertices.size();
             }
 
+            ///> The triangles and the vertices are stored contiguously, so they can be
+            ///> uploaded to a GPU buffer without being copied first.
+            const std::vector<TRI>& Triangles() const { return m_triangles; }
+            const std::vector<VECTOR2I>& Vertices() const { return m_vertices; }
+
         private:
 
-            std::deque<TRI> m_triangles;
-            std::deque<VECTOR2I> m_vertices;
+            std::vector<TRI> m_triangles;
+            std::vector<VECTOR2I> m_vertices;
         };
 
         /**
@@ -240,7 +258,7 @@ class SHAPE_POLY_SET : public SHAPE
 
             const T& Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].CPoint(
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CPoint(
                         m_currentVertex );
             }
 
@@ -363,7 +381,8 @@ class SHAPE_POLY_SET : public SHAPE
 
             T Get()
             {
-                return m_poly->Polygon( m_currentPolygon )[m_currentContour].Segment( m_currentSegment );
+                return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CSegment(
+                        m_currentSegment );
             }
 
             T operator*()
@@ -446,9 +465,11 @@ class SHAPE_POLY_SET : public SHAPE
 
         /**
          * Copy constructor SHAPE_POLY_SET
-         * Performs a deep copy of \p aOther into \p this.
+         * Performs a deep copy of the polygons of \p aOther into \p this.  The cached
+         * triangulation is immutable once built, so it is shared with \p aOther unless
+         * \p aDeepCopy is set.
          * @param aOther is the SHAPE_POLY_SET object that will be copied.
-         * @param aDeepCopy if true, make new copies of the triangulated unique_ptr vector
+         * @param aDeepCopy if true, make new copies of the triangulated polygons
          */
         SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy = false );
 
@@ -587,6 +608,7 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aIndex-th outline in the set
         SHAPE_LINE_CHAIN& Outline( int aIndex )
         {
+            m_polysExposed = true;
             return m_polys[aIndex][0];
         }
 
@@ -609,12 +631,14 @@ class SHAPE_POLY_SET : public SHAPE
         ///> Returns the reference to aHole-th hole in the aIndex-th outline
         SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
         {
+            m_polysExposed = true;
             return m_polys[aOutline][aHole + 1];
         }
 
         ///> Returns the aIndex-th subpolygon in the set
         POLYGON& Polygon( int aIndex )
         {
+            m_polysExposed = true;
             return m_polys[aIndex];
         }
 
@@ -657,6 +681,8 @@ class SHAPE_POLY_SET : public SHAPE
         {
             ITERATOR iter;
 
+            m_polysExposed = true;
+
             iter.m_poly = this;
             iter.m_currentPolygon = aFirst;
             iter.m_lastPolygon = aLast < 0 ? OutlineCount() - 1 : aLast;
@@ -849,6 +875,12 @@ class SHAPE_POLY_SET : public SHAPE
         ///> For aFastMode meaning, see function booleanOp
         void BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
 
+        ///> Performs boolean polyset union of this set and all the sets in aShapes in a
+        ///> single pass, which is much faster than adding them one by one.
+        ///> For aFastMode meaning, see function booleanOp
+        void BooleanAdd( const std::vector<const SHAPE_POLY_SET*>& aShapes,
+                         POLYGON_MODE aFastMode );
+
         ///> Performs boolean polyset difference
         ///> For aFastMode meaning, see function booleanOp
         void BooleanSubtract( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode );
@@ -1213,6 +1245,8 @@ class SHAPE_POLY_SET : public SHAPE
         bool IsVertexInHole( int aGlobalIdx );
 
     private:
+        class EDGE_INDEX;
+
         void fractureSingle( POLYGON& paths );
         void unfractureSingle ( POLYGON& path );
         void importTree( ClipperLib::PolyTree* tree );
@@ -1249,11 +1283,12 @@ class SHAPE_POLY_SET : public SHAPE
          * @param aUseBBoxCaches gives faster performance when multiple calls are made with no
          *                       editing in between, but the caller MUST cache the bbox caches
          *                       before calling (via BuildBBoxCaches(), above)
+         * @param aIndex         is the edge index of the set, or nullptr if it is not built.
          * @return bool - true if aP is inside aSubpolyIndex-th polygon; false in any other
          *         case.
          */
         bool containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
-                             bool aUseBBoxCaches = false ) const;
+                             bool aUseBBoxCaches, const EDGE_INDEX* aIndex ) const;
 
         /**
          * Operations ChamferPolygon and FilletPolygon are computed under the private chamferFillet
@@ -1296,7 +1331,12 @@ class SHAPE_POLY_SET : public SHAPE
 
         SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
 
-        void CacheTriangulation();
+        /**
+         * (Re)builds the triangulation of the set if it is not up to date.
+         * @param aParallel allows spreading large sets over several threads.  Callers which
+         *                  already triangulate several sets concurrently should pass false.
+         */
+        void CacheTriangulation( bool aParallel = true );
         bool IsTriangulationUpToDate() const;
 
         MD5_HASH GetHash() const;
@@ -1305,10 +1345,50 @@ class SHAPE_POLY_SET : public SHAPE
 
         MD5_HASH checksum() const;
 
-        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
+        /**
+         * Triangulates the outlines of a set without holes, spreading large sets over several
+         * threads if aParallel is true.  The triangulated polygons are appended to aResult in
+         * the order of the outlines, and the outlines which could not be triangulated are added
+         * to aFailed.
+         */
+        static void triangulateOutlines( const SHAPE_POLY_SET& aPolys,
+                std::vector<std::shared_ptr<TRIANGULATED_POLYGON>>& aResult,
+                SHAPE_POLY_SET& aFailed, bool aParallel );
+
+        ///> Returns the edge index, building it if the set has been queried often enough, or
+        ///> nullptr if the set is not worth indexing yet.
+        std::shared_ptr<const EDGE_INDEX> edgeIndex() const;
+
+        ///> Drops the edge index and restarts counting the queries.  Must be called by all the
+        ///> methods which modify the polygons.
+        void invalidateEdgeIndex()
+        {
+            if( m_edgeIndexQueries.load( std::memory_order_relaxed ) != 0 )
+                resetEdgeIndex();
+        }
+
+        void resetEdgeIndex();
+
+        ///> Triangulated polygons are never modified after CacheTriangulation() builds them,
+        ///> so copies of this set share them instead of duplicating the vertex storage.
+        std::vector<std::shared_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
         bool m_triangulationValid = false;
         MD5_HASH m_hash;
 
+        ///> The edge index is never modified once built either, and is shared between copies.
+        ///> It is only accessed with the atomic shared_ptr functions, as it is built lazily by
+        ///> const queries which may run concurrently.
+        mutable std::shared_ptr<const EDGE_INDEX> m_edgeIndex;
+
+        ///> Number of queries since the last modification, or -1 if no polygon is large enough
+        ///> to be indexed.  Never 0 when the index exists.
+        mutable std::atomic<int> m_edgeIndexQueries{ 0 };
+
+        ///> True when a non-const reference to the polygons has been given out since the edge
+        ///> index was last built or checked, as the polygons may then have been modified behind
+        ///> its back.  Cleared by the next query.
+        mutable std::atomic<bool> m_polysExposed{ false };
+
 };
 
 #endif
@@ -35,6 +35,19 @@ public:
      */
     std::string Format();
 
+    /**
+     * @return the 16 bytes of the hash as 32 lower case hexadecimal digits, the form used to
+     * store the hash in files.
+     */
+    std::string ToHexString() const;
+
+    /**
+     * Sets the hash from a string made by ToHexString().
+     *
+     * @return true if aHex is a valid hash, false otherwise (the hash is then left invalid).
+     */
+    bool FromHexString( const std::string& aHex );
+
 private:
     struct MD5_CTX {
        uint8_t data[64];
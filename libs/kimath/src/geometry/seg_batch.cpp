@@ -0,0 +1,285 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+
+// The filter loop is built twice on x86-64 Linux, for AVX2 and for the baseline instruction
+// set, and the loader picks the best one for the CPU.  Elsewhere the compiler vectorizes it
+// for the target instruction set (if at all).
+#if defined( __GNUC__ ) && !defined( __clang__ ) && defined( __x86_64__ ) && defined( __linux__ )
+#define SEG_BATCH_KERNEL __attribute__( ( target_clones( "avx2", "default" ) ) )
+#else
+#define SEG_BATCH_KERNEL
+#endif
+
+
+namespace
+{
+
+///> Number of segments filtered at once, small enough for the flags to stay on the stack
+const int BLOCK_SIZE = 256;
+
+
+/**
+ * An area around the query: the bounding boxes of the segments which may be close enough
+ * to the query intersect it.  The bounds are inclusive, and clamped to the range of int.
+ */
+struct QUERY_BOX
+{
+    QUERY_BOX( const VECTOR2I& aA, const VECTOR2I& aB, int64_t aMargin )
+    {
+        m_xmin = clamp( (int64_t) std::min( aA.x, aB.x ) - aMargin );
+        m_xmax = clamp( (int64_t) std::max( aA.x, aB.x ) + aMargin );
+        m_ymin = clamp( (int64_t) std::min( aA.y, aB.y ) - aMargin );
+        m_ymax = clamp( (int64_t) std::max( aA.y, aB.y ) + aMargin );
+    }
+
+    static int clamp( int64_t aValue )
+    {
+        return (int) std::max<int64_t>( INT_MIN, std::min<int64_t>( INT_MAX, aValue ) );
+    }
+
+    int m_xmin, m_xmax, m_ymin, m_ymax;
+};
+
+
+/**
+ * Sets aFlags[i] for the segments (from aPoints[i] to aPoints[i + 1]) whose bounding box
+ * intersects aBox.  This is the loop which runs on all the segments, so it is kept free of
+ * branches and of 64 bit multiplies for the compiler to vectorize it.
+ */
+SEG_BATCH_KERNEL
+void filterSegments( const VECTOR2I* aPoints, int aCount, const QUERY_BOX& aBox,
+                     uint8_t* aFlags )
+{
+    const int xmin = aBox.m_xmin;
+    const int xmax = aBox.m_xmax;
+    const int ymin = aBox.m_ymin;
+    const int ymax = aBox.m_ymax;
+
+    for( int i = 0; i < aCount; ++i )
+    {
+        const int ax = aPoints[i].x;
+        const int bx = aPoints[i + 1].x;
+        const int ay = aPoints[i].y;
+        const int by = aPoints[i + 1].y;
+
+        aFlags[i] = ( ( ax >= xmin ) | ( bx >= xmin ) ) & ( ( ax <= xmax ) | ( bx <= xmax ) )
+                  & ( ( ay >= ymin ) | ( by >= ymin ) ) & ( ( ay <= ymax ) | ( by <= ymax ) );
+    }
+}
+
+
+/**
+ * Sets aFlags for the aCount segments of a chain of aPointCount points starting at segment
+ * aFirst, including the closing segment if it is one of them.
+ */
+void filterChain( const VECTOR2I* aPoints, int aPointCount, int aFirst, int aCount,
+                  const QUERY_BOX& aBox, uint8_t* aFlags )
+{
+    int open = std::max( 0, std::min( aCount, aPointCount - 1 - aFirst ) );
+
+    if( open > 0 )
+        filterSegments( aPoints + aFirst, open, aBox, aFlags );
+
+    if( open < aCount )
+    {
+        const VECTOR2I closing[2] = { aPoints[aPointCount - 1], aPoints[0] };
+
+        filterSegments( closing, 1, aBox, aFlags + open );
+    }
+}
+
+
+/**
+ * @return a margin such that all the segments at a squared distance smaller than aSquaredDist
+ * have their bounding box within the margin.
+ */
+int64_t marginFor( SEG::ecoord aSquaredDist )
+{
+    // The exact tests run afterwards, so a margin slightly too large is harmless
+    return (int64_t) std::sqrt( (double) aSquaredDist ) + 1;
+}
+
+}
+
+
+SEG_BATCH::SEG_BATCH( const SHAPE_LINE_CHAIN& aChain ) :
+        m_points( aChain.CPoints().data() ),
+        m_pointCount( aChain.PointCount() ),
+        m_count( aChain.SegmentCount() )
+{
+}
+
+
+int SEG_BATCH::Collide( const SEG& aSeg, int aClearance ) const
+{
+    // SEG::Collide() reports the segments crossing aSeg, which have their bounding box
+    // intersecting the one of aSeg, and the segments closer than aClearance, which have it
+    // within aClearance.  The fast path of SEG::PointCloserThan() for 45 degree segments is
+    // only exact to a unit or so, hence the extra margin.
+    QUERY_BOX box( aSeg.A, aSeg.B, std::abs( (int64_t) aClearance ) + 2 );
+    uint8_t   flags[BLOCK_SIZE];
+
+    for( int first = 0; first < m_count; first += BLOCK_SIZE )
+    {
+        int count = std::min( BLOCK_SIZE, m_count - first );
+
+        filterChain( m_points, m_pointCount, first, count, box, flags );
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( flags[i] && Segment( first + i ).Collide( aSeg, aClearance ) )
+                return first + i;
+        }
+    }
+
+    return -1;
+}
+
+
+SEG::ecoord SEG_BATCH::SquaredDistance( const VECTOR2I& aP, int* aIndex ) const
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+    int         bestIndex = -1;
+    uint8_t     flags[BLOCK_SIZE];
+
+    for( int first = 0; first < m_count && best > 0; first += BLOCK_SIZE )
+    {
+        int count = std::min( BLOCK_SIZE, m_count - first );
+
+        // The nearest point of a segment is in its bounding box, so the segments closer than
+        // the best one so far have their box within that distance of aP
+        if( bestIndex >= 0 )
+        {
+            filterChain( m_points, m_pointCount, first, count,
+                         QUERY_BOX( aP, aP, marginFor( best ) ), flags );
+        }
+        else
+        {
+            std::fill( flags, flags + count, 1 );
+        }
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( !flags[i] )
+                continue;
+
+            SEG::ecoord d = Segment( first + i ).SquaredDistance( aP );
+
+            if( d < best )
+            {
+                best = d;
+                bestIndex = first + i;
+            }
+        }
+    }
+
+    if( aIndex )
+        *aIndex = bestIndex;
+
+    return best;
+}
+
+
+SEG::ecoord SEG_BATCH::SquaredDistance( const SEG& aSeg, int* aIndex ) const
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+    int         bestIndex = -1;
+    uint8_t     flags[BLOCK_SIZE];
+
+    for( int first = 0; first < m_count && best > 0; first += BLOCK_SIZE )
+    {
+        int count = std::min( BLOCK_SIZE, m_count - first );
+
+        if( bestIndex >= 0 )
+        {
+            filterChain( m_points, m_pointCount, first, count,
+                         QUERY_BOX( aSeg.A, aSeg.B, marginFor( best ) ), flags );
+        }
+        else
+        {
+            std::fill( flags, flags + count, 1 );
+        }
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( !flags[i] )
+                continue;
+
+            SEG::ecoord d = Segment( first + i ).SquaredDistance( aSeg );
+
+            if( d < best )
+            {
+                best = d;
+                bestIndex = first + i;
+            }
+        }
+    }
+
+    if( aIndex )
+        *aIndex = bestIndex;
+
+    return best;
+}
+
+
+OPT_VECTOR2I SEG_BATCH::Intersect( const SEG& aSeg, int* aIndex ) const
+{
+    // Crossing segments have intersecting bounding boxes
+    QUERY_BOX box( aSeg.A, aSeg.B, 0 );
+    uint8_t   flags[BLOCK_SIZE];
+
+    for( int first = 0; first < m_count; first += BLOCK_SIZE )
+    {
+        int count = std::min( BLOCK_SIZE, m_count - first );
+
+        filterChain( m_points, m_pointCount, first, count, box, flags );
+
+        for( int i = 0; i < count; ++i )
+        {
+            if( !flags[i] )
+                continue;
+
+            if( OPT_VECTOR2I ip = Segment( first + i ).Intersect( aSeg ) )
+            {
+                if( aIndex )
+                    *aIndex = first + i;
+
+                return ip;
+            }
+        }
+    }
+
+    if( aIndex )
+        *aIndex = -1;
+
+    return OPT_VECTOR2I();
+}
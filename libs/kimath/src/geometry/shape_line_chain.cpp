@@ -25,10 +25,12 @@
 #include <algorithm>
 #include <limits.h>          // for INT_MAX
 #include <math.h>            // for hypot
+#include <cstdlib>           // for abs
 #include <string>            // for basic_string
 
 #include <clipper.hpp>
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <math/box2.h>       // for BOX2I
 #include <math/util.h>  // for rescale
@@ -49,11 +51,10 @@ ClipperLib::Path SHAPE_LINE_CHAIN::convertToClipper( bool aRequiredOrientation )
 {
     ClipperLib::Path c_path;
 
-    for( int i = 0; i < PointCount(); i++ )
-    {
-        const VECTOR2I& vertex = CPoint( i );
-        c_path.push_back( ClipperLib::IntPoint( vertex.x, vertex.y ) );
-    }
+    c_path.reserve( m_points.size() );
+
+    for( const VECTOR2I& vertex : m_points )
+        c_path.emplace_back( vertex.x, vertex.y );
 
     if( Orientation( c_path ) != aRequiredOrientation )
         ReversePath( c_path );
@@ -109,24 +110,7 @@ void SHAPE_LINE_CHAIN::Rotate( double aAngle, const VECTOR2I& aCenter )
 
 bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance ) const
 {
-    BOX2I box_a( aSeg.A, aSeg.B - aSeg.A );
-    BOX2I::ecoord_type dist_sq = (BOX2I::ecoord_type) aClearance * aClearance;
-
-    for( int i = 0; i < SegmentCount(); i++ )
-    {
-        const SEG& s = CSegment( i );
-        BOX2I box_b( s.A, s.B - s.A );
-
-        BOX2I::ecoord_type d = box_a.SquaredDistance( box_b );
-
-        if( d < dist_sq )
-        {
-            if( s.Collide( aSeg, aClearance ) )
-                return true;
-        }
-    }
-
-    return false;
+    return SEG_BATCH( *this ).Collide( aSeg, aClearance ) >= 0;
 }
 
 
@@ -267,15 +251,10 @@ void SHAPE_LINE_CHAIN::Remove( int aStartIndex, int aEndIndex )
 
 int SHAPE_LINE_CHAIN::Distance( const VECTOR2I& aP, bool aOutlineOnly ) const
 {
-    int d = INT_MAX;
-
     if( IsClosed() && PointInside( aP ) && !aOutlineOnly )
         return 0;
 
-    for( int s = 0; s < SegmentCount(); s++ )
-        d = std::min( d, CSegment( s ).Distance( aP ) );
-
-    return d;
+    return SEG_BATCH( *this ).Distance( aP );
 }
 
 
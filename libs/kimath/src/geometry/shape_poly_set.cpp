@@ -30,11 +30,14 @@
 #include <assert.h>                          // for assert
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <future>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
+#include <tuple>                             // for tie
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
@@ -43,6 +46,7 @@
 #include <geometry/geometry_utils.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
@@ -72,13 +76,29 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther, bool aDeepCopy ) :
 {
     if( aOther.IsTriangulationUpToDate() )
     {
-        for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
-            m_triangulatedPolys.push_back(
-                    std::make_unique<TRIANGULATED_POLYGON>( *aOther.TriangulatedPolygon( i ) ) );
+        if( aDeepCopy )
+        {
+            for( unsigned i = 0; i < aOther.TriangulatedPolyCount(); i++ )
+                m_triangulatedPolys.push_back(
+                        std::make_shared<TRIANGULATED_POLYGON>( *aOther.TriangulatedPolygon( i ) ) );
+        }
+        else
+        {
+            m_triangulatedPolys = aOther.m_triangulatedPolys;
+        }
 
         m_hash = aOther.GetHash();
         m_triangulationValid = true;
     }
+
+    // The other set's index may be stale if its polygons have been exposed, while no
+    // reference to the copied polygons exists yet to validate it against
+    if( !aOther.m_polysExposed )
+    {
+        m_edgeIndex = std::atomic_load( &aOther.m_edgeIndex );
+        m_edgeIndexQueries.store( aOther.m_edgeIndexQueries.load( std::memory_order_relaxed ),
+                                  std::memory_order_relaxed );
+    }
 }
 
 
@@ -150,7 +170,7 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
         for( unsigned int polygonIdx = 0; polygonIdx < selectedPolygon; polygonIdx++ )
         {
-            currentPolygon = Polygon( polygonIdx );
+            currentPolygon = m_polys[polygonIdx];
 
             for( unsigned int contourIdx = 0; contourIdx < currentPolygon.size(); contourIdx++ )
             {
@@ -158,7 +178,7 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
             }
         }
 
-        currentPolygon = Polygon( selectedPolygon );
+        currentPolygon = m_polys[selectedPolygon];
 
         for( unsigned int contourIdx = 0; contourIdx < selectedContour; contourIdx++ )
         {
@@ -178,6 +198,8 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
 int SHAPE_POLY_SET::NewOutline()
 {
+    invalidateEdgeIndex();
+
     SHAPE_LINE_CHAIN empty_path;
     POLYGON poly;
 
@@ -190,6 +212,8 @@ int SHAPE_POLY_SET::NewOutline()
 
 int SHAPE_POLY_SET::NewHole( int aOutline )
 {
+    invalidateEdgeIndex();
+
     SHAPE_LINE_CHAIN empty_path;
 
     empty_path.SetClosed( true );
@@ -207,6 +231,8 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
 int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDuplication )
 {
+    invalidateEdgeIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -230,6 +256,8 @@ int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDu
 
 void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, VECTOR2I aNewVertex )
 {
+    invalidateEdgeIndex();
+
     VERTEX_INDEX index;
 
     if( aGlobalIndex < 0 )
@@ -283,7 +311,7 @@ SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 
     for( int index = aFirstPolygon; index < aLastPolygon; index++ )
     {
-        newPolySet.m_polys.push_back( Polygon( index ) );
+        newPolySet.m_polys.push_back( CPolygon( index ) );
     }
 
     return newPolySet;
@@ -415,6 +443,8 @@ bool SHAPE_POLY_SET::IsSelfIntersecting() const
 
 int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 {
+    invalidateEdgeIndex();
+
     assert( aOutline.IsClosed() );
 
     POLYGON poly;
@@ -429,6 +459,8 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
 int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 {
+    invalidateEdgeIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -462,13 +494,13 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
 
     c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
 
-    for( auto poly : aShape.m_polys )
+    for( const POLYGON& poly : aShape.m_polys )
     {
         for( size_t i = 0 ; i < poly.size(); i++ )
             c.AddPath( poly[i].convertToClipper( i == 0 ), ptSubject, true );
     }
 
-    for( auto poly : aOtherShape.m_polys )
+    for( const POLYGON& poly : aOtherShape.m_polys )
     {
         for( size_t i = 0; i < poly.size(); i++ )
             c.AddPath( poly[i].convertToClipper( i == 0 ), ptClip, true );
@@ -488,6 +520,38 @@ void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode
 }
 
 
+void SHAPE_POLY_SET::BooleanAdd( const std::vector<const SHAPE_POLY_SET*>& aShapes,
+                                 POLYGON_MODE aFastMode )
+{
+    Clipper c;
+
+    c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
+
+    // All the operands are subjects of a single union, so Clipper builds its scanbeam
+    // and edge lists once instead of once per operand.
+    for( const POLYGON& poly : m_polys )
+    {
+        for( size_t i = 0; i < poly.size(); i++ )
+            c.AddPath( poly[i].convertToClipper( i == 0 ), ptSubject, true );
+    }
+
+    for( const SHAPE_POLY_SET* shape : aShapes )
+    {
+        for( const POLYGON& poly : shape->m_polys )
+        {
+            for( size_t i = 0; i < poly.size(); i++ )
+                c.AddPath( poly[i].convertToClipper( i == 0 ), ptSubject, true );
+        }
+    }
+
+    PolyTree solution;
+
+    c.Execute( ctUnion, solution, pftNonZero, pftNonZero );
+
+    importTree( &solution );
+}
+
+
 void SHAPE_POLY_SET::BooleanSubtract( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
     booleanOp( ctDifference, b, aFastMode );
@@ -618,20 +682,22 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
 
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
+    invalidateEdgeIndex();
+
     m_polys.clear();
 
     for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
     {
         if( !n->IsHole() )
         {
-            POLYGON paths;
+            m_polys.emplace_back();
+
+            POLYGON& paths = m_polys.back();
             paths.reserve( n->Childs.size() + 1 );
-            paths.push_back( n->Contour );
+            paths.emplace_back( n->Contour );
 
             for( unsigned int i = 0; i < n->Childs.size(); i++ )
-                paths.push_back( n->Childs[i]->Contour );
-
-            m_polys.push_back( paths );
+                paths.emplace_back( n->Childs[i]->Contour );
         }
     }
 }
@@ -847,6 +913,8 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
 void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
+    invalidateEdgeIndex();
+
     Simplify( aFastMode );    // remove overlapping holes/degeneracy
 
     for( POLYGON& paths : m_polys )
@@ -1034,6 +1102,8 @@ bool SHAPE_POLY_SET::HasHoles() const
 
 void SHAPE_POLY_SET::Unfracture( POLYGON_MODE aFastMode )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& path : m_polys )
     {
         unfractureSingle( path );
@@ -1058,9 +1128,11 @@ int SHAPE_POLY_SET::NormalizeAreaOutlines()
     // Note also we are using SHAPE_POLY_SET::PM_STRICTLY_SIMPLE in polygon
     // calculations, but it is not mandatory. It is used mainly
     // because there is usually only very few vertices in area outlines
-    SHAPE_POLY_SET::POLYGON& outline = Polygon( 0 );
+    SHAPE_POLY_SET::POLYGON& outline = m_polys[0];
     SHAPE_POLY_SET holesBuffer;
 
+    invalidateEdgeIndex();
+
     // Move holes stored in outline to holesBuffer:
     // The first SHAPE_LINE_CHAIN is the main outline, others are holes
     while( outline.size() > 1 )
@@ -1111,6 +1183,8 @@ const std::string SHAPE_POLY_SET::Format() const
 
 bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
 {
+    invalidateEdgeIndex();
+
     std::string tmp;
 
     aStream >> tmp;
@@ -1168,6 +1242,472 @@ bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
 }
 
 
+/**
+ * Bounding box tree over the edges of the large polygons of a set.
+ *
+ * The edges themselves are not stored: the leaves are runs of consecutive segments of a
+ * contour, whose bounding boxes are tight as contours are continuous, and the upper levels
+ * group consecutive nodes of the level below.  This keeps the index small and fast to build,
+ * as no sorting is needed.
+ *
+ * Queries read the segments from the polygons they are given, which must be the ones the
+ * index was built from (or a copy of them).
+ */
+class SHAPE_POLY_SET::EDGE_INDEX
+{
+public:
+    ///> Area of a query, in 64 bits so it can be inflated by any clearance
+    struct AREA
+    {
+        AREA( const VECTOR2I& aP, int aInflate = 0 ) :
+                m_minX( (int64_t) aP.x - aInflate ),
+                m_minY( (int64_t) aP.y - aInflate ),
+                m_maxX( (int64_t) aP.x + aInflate ),
+                m_maxY( (int64_t) aP.y + aInflate )
+        {}
+
+        AREA( const SEG& aSeg, int aInflate = 0 ) :
+                m_minX( (int64_t) std::min( aSeg.A.x, aSeg.B.x ) - aInflate ),
+                m_minY( (int64_t) std::min( aSeg.A.y, aSeg.B.y ) - aInflate ),
+                m_maxX( (int64_t) std::max( aSeg.A.x, aSeg.B.x ) + aInflate ),
+                m_maxY( (int64_t) std::max( aSeg.A.y, aSeg.B.y ) + aInflate )
+        {}
+
+        int64_t m_minX, m_minY, m_maxX, m_maxY;
+    };
+
+    EDGE_INDEX( const POLYSET& aPolys, const MD5_HASH& aChecksum );
+
+    ///> Returns the checksum of the polygons the index was built for
+    const MD5_HASH& Checksum() const
+    {
+        return m_checksum;
+    }
+
+    ///> Returns true if the aPolygon-th polygon is large enough to be indexed
+    bool IsIndexed( int aPolygon ) const
+    {
+        return !m_trees[aPolygon].empty();
+    }
+
+    ///> Returns true if no polygon of the set is indexed
+    bool IsEmpty() const
+    {
+        return m_indexedPolygons == 0;
+    }
+
+    /**
+     * Calls aVisitor( aContour, aFirst, aCount ) for the runs of segments of an indexed
+     * polygon whose bounding box intersects aArea, until it returns false.
+     * @return false if the visitor stopped the query.
+     */
+    template <typename Visitor>
+    bool Query( int aPolygon, const AREA& aArea, Visitor aVisitor ) const
+    {
+        const TREE& tree = m_trees[aPolygon];
+
+        return query( tree, tree.size() - 1, 0, tree.back().size(), aArea, aVisitor );
+    }
+
+    /**
+     * Returns the minimum of aDistance( aSeg ) over the segments of an indexed polygon.  The
+     * distance to aArea must be a lower bound of aDistance, so the runs of segments further
+     * away than the closest segment found so far are skipped.
+     */
+    template <typename Distance>
+    int MinDistance( const POLYGON& aPoly, int aPolygon, const AREA& aArea,
+                     Distance aDistance ) const
+    {
+        const TREE& tree = m_trees[aPolygon];
+        int         best = std::numeric_limits<int>::max();
+
+        minDistance( aPoly, tree, tree.size() - 1, 0, tree.back().size(), aArea, aDistance,
+                     best );
+
+        return best;
+    }
+
+    ///> Same as SHAPE_LINE_CHAIN::PointOnEdge() for the contours of an indexed polygon, or
+    ///> only for its outline.
+    bool PointOnEdge( const POLYGON& aPoly, int aPolygon, const VECTOR2I& aP, int aAccuracy,
+                      bool aOutlineOnly ) const;
+
+    ///> Same as SHAPE_POLY_SET::containsSingle() for an indexed polygon
+    bool Contains( const POLYGON& aPoly, int aPolygon, const VECTOR2I& aP,
+                   int aAccuracy ) const;
+
+private:
+    ///> Number of segments in a leaf, and of children of an inner node
+    static const int NODE_SIZE = 16;
+
+    ///> Polygons with fewer segments are faster to scan than to query
+    static const int MIN_INDEXED_SEGMENTS = 64;
+
+    struct NODE
+    {
+        int m_minX, m_minY, m_maxX, m_maxY;
+        int m_contour;    ///< contour of the segments of a leaf, -1 for an inner node
+        int m_first;      ///< first segment of a leaf, or first child of an inner node
+        int m_count;      ///< number of segments or of children
+    };
+
+    ///> One vector of nodes per level, leaves first
+    typedef std::vector<std::vector<NODE>> TREE;
+
+    static bool intersects( const NODE& aNode, const AREA& aArea )
+    {
+        return aNode.m_maxX >= aArea.m_minX && aNode.m_minX <= aArea.m_maxX
+               && aNode.m_maxY >= aArea.m_minY && aNode.m_minY <= aArea.m_maxY;
+    }
+
+    static SEG::ecoord squaredDistance( const NODE& aNode, const AREA& aArea )
+    {
+        SEG::ecoord dx = std::max<int64_t>( { 0, aNode.m_minX - aArea.m_maxX,
+                                              aArea.m_minX - aNode.m_maxX } );
+        SEG::ecoord dy = std::max<int64_t>( { 0, aNode.m_minY - aArea.m_maxY,
+                                              aArea.m_minY - aNode.m_maxY } );
+
+        return dx * dx + dy * dy;
+    }
+
+    template <typename Visitor>
+    bool query( const TREE& aTree, int aLevel, int aFirst, int aCount, const AREA& aArea,
+                Visitor& aVisitor ) const
+    {
+        const std::vector<NODE>& nodes = aTree[aLevel];
+
+        for( int ii = aFirst; ii < aFirst + aCount; ++ii )
+        {
+            const NODE& node = nodes[ii];
+
+            if( !intersects( node, aArea ) )
+                continue;
+
+            if( aLevel == 0 )
+            {
+                if( !aVisitor( node.m_contour, node.m_first, node.m_count ) )
+                    return false;
+            }
+            else if( !query( aTree, aLevel - 1, node.m_first, node.m_count, aArea, aVisitor ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename Distance>
+    void minDistance( const POLYGON& aPoly, const TREE& aTree, int aLevel, int aFirst,
+                      int aCount, const AREA& aArea, Distance& aDistance, int& aBest ) const
+    {
+        const std::vector<NODE>&    nodes = aTree[aLevel];
+        std::pair<SEG::ecoord, int> order[NODE_SIZE];
+
+        for( int ii = 0; ii < aCount; ++ii )
+        {
+            order[ii].first = squaredDistance( nodes[aFirst + ii], aArea );
+            order[ii].second = aFirst + ii;
+        }
+
+        // Visit the closest nodes first, to tighten the bound early
+        std::sort( order, order + aCount );
+
+        for( int ii = 0; ii < aCount && aBest > 0; ++ii )
+        {
+            // Distances are rounded to integers, so only skip the nodes which cannot contain
+            // a segment closer than the best one, even after rounding
+            SEG::ecoord limit = (SEG::ecoord) aBest + 1;
+
+            if( order[ii].first >= limit * limit )
+                break;
+
+            const NODE& node = nodes[order[ii].second];
+
+            if( aLevel > 0 )
+            {
+                minDistance( aPoly, aTree, aLevel - 1, node.m_first, node.m_count, aArea,
+                             aDistance, aBest );
+                continue;
+            }
+
+            const SHAPE_LINE_CHAIN& chain = aPoly[node.m_contour];
+
+            for( int seg = node.m_first; seg < node.m_first + node.m_count; ++seg )
+                aBest = std::min( aBest, aDistance( chain.CSegment( seg ) ) );
+        }
+    }
+
+    std::vector<TREE> m_trees;
+    int               m_indexedPolygons;
+    MD5_HASH          m_checksum;
+};
+
+
+SHAPE_POLY_SET::EDGE_INDEX::EDGE_INDEX( const POLYSET& aPolys, const MD5_HASH& aChecksum ) :
+        m_trees( aPolys.size() ),
+        m_indexedPolygons( 0 ),
+        m_checksum( aChecksum )
+{
+    for( size_t polygonIdx = 0; polygonIdx < aPolys.size(); polygonIdx++ )
+    {
+        const POLYGON& poly = aPolys[polygonIdx];
+        int            segmentCount = 0;
+        bool           closed = true;
+
+        // Open contours are never inside anything, leave them to the regular code
+        for( const SHAPE_LINE_CHAIN& chain : poly )
+        {
+            closed &= chain.IsClosed() && chain.PointCount() >= 3;
+            segmentCount += chain.SegmentCount();
+        }
+
+        if( !closed || segmentCount < MIN_INDEXED_SEGMENTS )
+            continue;
+
+        TREE& tree = m_trees[polygonIdx];
+
+        tree.emplace_back();
+        tree.back().reserve( segmentCount / NODE_SIZE + poly.size() );
+
+        for( size_t contour = 0; contour < poly.size(); contour++ )
+        {
+            const std::vector<VECTOR2I>& points = poly[contour].CPoints();
+            int                          pointCount = points.size();
+
+            for( int first = 0; first < pointCount; first += NODE_SIZE )
+            {
+                NODE leaf;
+
+                leaf.m_contour = contour;
+                leaf.m_first = first;
+                leaf.m_count = std::min( NODE_SIZE, pointCount - first );
+                leaf.m_minX = leaf.m_maxX = points[first].x;
+                leaf.m_minY = leaf.m_maxY = points[first].y;
+
+                // The last segment of the run ends on the first point of the next one
+                for( int ii = first + 1; ii <= first + leaf.m_count; ++ii )
+                {
+                    const VECTOR2I& pt = points[ii == pointCount ? 0 : ii];
+
+                    leaf.m_minX = std::min( leaf.m_minX, pt.x );
+                    leaf.m_minY = std::min( leaf.m_minY, pt.y );
+                    leaf.m_maxX = std::max( leaf.m_maxX, pt.x );
+                    leaf.m_maxY = std::max( leaf.m_maxY, pt.y );
+                }
+
+                tree.back().push_back( leaf );
+            }
+        }
+
+        while( tree.back().size() > 1 )
+        {
+            const std::vector<NODE>& children = tree.back();
+            std::vector<NODE>        parents;
+
+            parents.reserve( ( children.size() + NODE_SIZE - 1 ) / NODE_SIZE );
+
+            for( size_t first = 0; first < children.size(); first += NODE_SIZE )
+            {
+                NODE parent = children[first];
+
+                parent.m_contour = -1;
+                parent.m_first = first;
+                parent.m_count = std::min<int>( NODE_SIZE, children.size() - first );
+
+                for( int ii = 1; ii < parent.m_count; ++ii )
+                {
+                    const NODE& child = children[first + ii];
+
+                    parent.m_minX = std::min( parent.m_minX, child.m_minX );
+                    parent.m_minY = std::min( parent.m_minY, child.m_minY );
+                    parent.m_maxX = std::max( parent.m_maxX, child.m_maxX );
+                    parent.m_maxY = std::max( parent.m_maxY, child.m_maxY );
+                }
+
+                parents.push_back( parent );
+            }
+
+            tree.push_back( std::move( parents ) );
+        }
+
+        m_indexedPolygons++;
+    }
+}
+
+
+bool SHAPE_POLY_SET::EDGE_INDEX::PointOnEdge( const POLYGON& aPoly, int aPolygon,
+                                              const VECTOR2I& aP, int aAccuracy,
+                                              bool aOutlineOnly ) const
+{
+    bool found = false;
+
+    Query( aPolygon, AREA( aP, aAccuracy + 1 ),
+           [&]( int aContour, int aFirst, int aCount )
+           {
+               if( aOutlineOnly && aContour > 0 )
+                   return true;
+
+               const SHAPE_LINE_CHAIN& chain = aPoly[aContour];
+
+               for( int ii = aFirst; ii < aFirst + aCount; ++ii )
+               {
+                   const SEG s = chain.CSegment( ii );
+
+                   if( s.A == aP || s.B == aP || s.Distance( aP ) <= aAccuracy + 1 )
+                   {
+                       found = true;
+                       return false;
+                   }
+               }
+
+               return true;
+           } );
+
+    return found;
+}
+
+
+/**
+ * Returns true if a horizontal ray going from aP to the right crosses the segment (aP1, aP2),
+ * the same way as SHAPE_LINE_CHAIN::PointInside() counts the crossings.
+ */
+static inline bool crossesRay( const VECTOR2I& aP1, const VECTOR2I& aP2, const VECTOR2I& aP )
+{
+    if( ( aP1.y > aP.y ) == ( aP2.y > aP.y ) )
+        return false;
+
+    const VECTOR2I diff = aP2 - aP1;
+    const int      d = rescale( diff.x, ( aP.y - aP1.y ), diff.y );
+
+    return aP.x - aP1.x < d;
+}
+
+
+bool SHAPE_POLY_SET::EDGE_INDEX::Contains( const POLYGON& aPoly, int aPolygon,
+                                           const VECTOR2I& aP, int aAccuracy ) const
+{
+    // Only the segments which can cross the ray are visited.  The crossings of the outline
+    // are counted directly, for the holes the contours crossed an odd number of times by a
+    // run are collected.
+    bool             insideOutline = false;
+    std::vector<int> holeCrossings;
+    AREA             ray( aP );
+
+    ray.m_maxX = std::numeric_limits<int>::max();
+
+    Query( aPolygon, ray,
+           [&]( int aContour, int aFirst, int aCount )
+           {
+               const std::vector<VECTOR2I>& points = aPoly[aContour].CPoints();
+               int                          pointCount = points.size();
+               bool                         odd = false;
+
+               for( int ii = aFirst; ii < aFirst + aCount; ++ii )
+               {
+                   if( crossesRay( points[ii], points[ii + 1 == pointCount ? 0 : ii + 1], aP ) )
+                       odd = !odd;
+               }
+
+               if( odd && aContour == 0 )
+                   insideOutline = !insideOutline;
+               else if( odd )
+                   holeCrossings.push_back( aContour );
+
+               return true;
+           } );
+
+    // Same edge handling as SHAPE_LINE_CHAIN::PointInside() for the outline
+    if( aAccuracy == 0 )
+    {
+        if( !insideOutline || PointOnEdge( aPoly, aPolygon, aP, 0, true ) )
+            return false;
+    }
+    else if( aAccuracy == 1 )
+    {
+        if( !insideOutline )
+            return false;
+    }
+    else if( !insideOutline && !PointOnEdge( aPoly, aPolygon, aP, aAccuracy - 1, true ) )
+    {
+        return false;
+    }
+
+    // The point is inside a hole if the hole was crossed an odd number of times
+    std::sort( holeCrossings.begin(), holeCrossings.end() );
+
+    for( size_t ii = 0; ii < holeCrossings.size(); )
+    {
+        size_t next = ii + 1;
+
+        while( next < holeCrossings.size() && holeCrossings[next] == holeCrossings[ii] )
+            next++;
+
+        if( ( next - ii ) % 2 )
+            return false;
+
+        ii = next;
+    }
+
+    return true;
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET::EDGE_INDEX> SHAPE_POLY_SET::edgeIndex() const
+{
+    // Temporary sets are often queried once or twice only, building the index would cost
+    // more than it saves.
+    static const int MIN_QUERIES = 3;
+
+    int queries = m_edgeIndexQueries.load( std::memory_order_relaxed );
+
+    if( queries < 0 )
+        return nullptr;
+
+    if( queries < MIN_QUERIES )
+    {
+        m_edgeIndexQueries.fetch_add( 1, std::memory_order_relaxed );
+        return nullptr;
+    }
+
+    std::shared_ptr<const EDGE_INDEX> index = std::atomic_load( &m_edgeIndex );
+
+    if( index && !m_polysExposed.load( std::memory_order_relaxed ) )
+        return index;
+
+    // Contours or vertices may have been modified through a non-const reference handed out
+    // since the index was built, without any modifier of the set being called.  Check them
+    // once, on the first query after the reference was handed out.
+    m_polysExposed.store( false, std::memory_order_relaxed );
+
+    MD5_HASH polysChecksum = checksum();
+
+    if( index && index->Checksum() == polysChecksum )
+        return index;
+
+    // Concurrent queries may build the index more than once, but they all build the same one
+    std::shared_ptr<const EDGE_INDEX> newIndex = std::make_shared<EDGE_INDEX>( m_polys,
+                                                                               polysChecksum );
+
+    if( newIndex->IsEmpty() )
+    {
+        m_edgeIndexQueries.store( -1, std::memory_order_relaxed );
+        return nullptr;
+    }
+
+    std::atomic_store( &m_edgeIndex, newIndex );
+
+    return newIndex;
+}
+
+
+void SHAPE_POLY_SET::resetEdgeIndex()
+{
+    m_edgeIndexQueries.store( 0, std::memory_order_relaxed );
+    std::atomic_store( &m_edgeIndex, std::shared_ptr<const EDGE_INDEX>() );
+}
+
+
 const BOX2I SHAPE_POLY_SET::BBox( int aClearance ) const
 {
     BOX2I bb;
@@ -1187,9 +1727,21 @@ const BOX2I SHAPE_POLY_SET::BBox( int aClearance ) const
 
 bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 {
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
+
     // Iterate through all the polygons in the set
-    for( const POLYGON& polygon : m_polys )
+    for( size_t polygonIdx = 0; polygonIdx < m_polys.size(); polygonIdx++ )
     {
+        const POLYGON& polygon = m_polys[polygonIdx];
+
+        if( index && index->IsIndexed( polygonIdx ) )
+        {
+            if( index->PointOnEdge( polygon, polygonIdx, aP, 0, false ) )
+                return true;
+
+            continue;
+        }
+
         // Iterate through all the line chains in the polygon
         for( const SHAPE_LINE_CHAIN& lineChain : polygon )
         {
@@ -1204,29 +1756,60 @@ bool SHAPE_POLY_SET::PointOnEdge( const VECTOR2I& aP ) const
 
 bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 {
-
-    SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
-
-    // Inflate the polygon if necessary.
-    if( aClearance > 0 )
-    {
-        // fixme: the number of arc segments should not be hardcoded
-        polySet.Inflate( aClearance, 8 );
-    }
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
 
     // We are going to check to see if the segment crosses an external
     // boundary.  However, if the full segment is inside the polyset, this
     // will not be true.  So we first test to see if one of the points is
     // inside.  If true, then we collide
-    if( polySet.Contains( aSeg.A ) )
-        return true;
+    for( size_t polygonIdx = 0; polygonIdx < m_polys.size(); polygonIdx++ )
+    {
+        if( containsSingle( aSeg.A, polygonIdx, 0, false, index.get() ) )
+            return true;
+    }
+
+    // Otherwise the segment has to cross an edge, or to come closer to it than the clearance
+    auto collides = [&]( const SEG& aPolygonEdge )
+    {
+        if( aClearance > 0 )
+            return aPolygonEdge.Distance( aSeg ) <= aClearance;
+        else
+            return (bool) aPolygonEdge.Intersect( aSeg, true );
+    };
 
-    for( SEGMENT_ITERATOR it = ( (SHAPE_POLY_SET*) this )->IterateSegmentsWithHoles(); it; it++ )
+    for( size_t polygonIdx = 0; polygonIdx < m_polys.size(); polygonIdx++ )
     {
-        SEG polygonEdge = *it;
+        const POLYGON& polygon = m_polys[polygonIdx];
 
-        if( polygonEdge.Intersect( aSeg, true ) )
-            return true;
+        if( index && index->IsIndexed( polygonIdx ) )
+        {
+            bool stopped = !index->Query( polygonIdx,
+                    EDGE_INDEX::AREA( aSeg, std::max( aClearance, 0 ) ),
+                    [&]( int aContour, int aFirst, int aCount )
+                    {
+                        for( int ii = aFirst; ii < aFirst + aCount; ++ii )
+                        {
+                            if( collides( polygon[aContour].CSegment( ii ) ) )
+                                return false;
+                        }
+
+                        return true;
+                    } );
+
+            if( stopped )
+                return true;
+
+            continue;
+        }
+
+        for( const SHAPE_LINE_CHAIN& lineChain : polygon )
+        {
+            for( int ii = 0; ii < lineChain.SegmentCount(); ii++ )
+            {
+                if( collides( lineChain.CSegment( ii ) ) )
+                    return true;
+            }
+        }
     }
 
     return false;
@@ -1235,28 +1818,27 @@ bool SHAPE_POLY_SET::Collide( const SEG& aSeg, int aClearance ) const
 
 bool SHAPE_POLY_SET::Collide( const VECTOR2I& aP, int aClearance ) const
 {
-    SHAPE_POLY_SET polySet = SHAPE_POLY_SET( *this );
+    // Without clearance, there is a collision if and only if the point is inside of the polygon
+    if( aClearance <= 0 )
+        return Contains( aP );
 
-    // Inflate the polygon if necessary.
-    if( aClearance > 0 )
-    {
-        // fixme: the number of arc segments should not be hardcoded
-        polySet.Inflate( aClearance, 8 );
-    }
-
-    // There is a collision if and only if the point is inside of the polygon.
-    return polySet.Contains( aP );
+    // Otherwise the point collides exactly when a null segment on it does
+    return Collide( SEG( aP, aP ), aClearance );
 }
 
 
 void SHAPE_POLY_SET::RemoveAllContours()
 {
+    invalidateEdgeIndex();
+
     m_polys.clear();
 }
 
 
 void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 {
+    invalidateEdgeIndex();
+
     // Default polygon is the last one
     if( aPolygonIdx < 0 )
         aPolygonIdx += m_polys.size();
@@ -1269,7 +1851,7 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 {
     int removed = 0;
 
-    ITERATOR iterator = IterateWithHoles();
+    CONST_ITERATOR iterator = CIterateWithHoles();
 
     VECTOR2I    contourStart = *iterator;
     VECTOR2I    segmentStart, segmentEnd;
@@ -1320,12 +1902,16 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
+    invalidateEdgeIndex();
+
     m_polys.erase( m_polys.begin() + aIdx );
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
+    invalidateEdgeIndex();
+
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
 }
 
@@ -1349,7 +1935,7 @@ bool SHAPE_POLY_SET::CollideVertex( const VECTOR2I& aPoint,
     // Convert clearance to double for precission when comparing distances
     clearance = aClearance;
 
-    for( ITERATOR iterator = IterateWithHoles(); iterator; iterator++ )
+    for( CONST_ITERATOR iterator = CIterateWithHoles(); iterator; iterator++ )
     {
         // Get the difference vector between current vertex and aPoint
         delta = *iterator - aPoint;
@@ -1380,23 +1966,59 @@ bool SHAPE_POLY_SET::CollideEdge( const VECTOR2I& aPoint,
     // Shows whether there was a collision
     bool collision = false;
 
-    SEGMENT_ITERATOR iterator;
+    // Among the edges at the same distance, the last one in iteration order is kept, so
+    // the result does not depend on the order the edge index visits them.
+    auto checkEdge = [&]( int aPolygon, int aContour, int aSegment, const SEG& aEdge )
+    {
+        int distance = aEdge.Distance( aPoint );
+
+        if( distance > aClearance )
+            return;
+
+        if( collision && distance == aClearance
+                && std::tie( aPolygon, aContour, aSegment )
+                           < std::tie( aClosestVertex.m_polygon, aClosestVertex.m_contour,
+                                       aClosestVertex.m_vertex ) )
+        {
+            return;
+        }
+
+        collision = true;
+
+        // Update aClearance to look for closer edges
+        aClearance = distance;
+
+        // Store the indices that identify the vertex
+        aClosestVertex.m_polygon = aPolygon;
+        aClosestVertex.m_contour = aContour;
+        aClosestVertex.m_vertex = aSegment;
+    };
+
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
+    EDGE_INDEX::AREA                  area( aPoint, std::max( aClearance, 0 ) );
 
-    for( iterator = IterateSegmentsWithHoles(); iterator; iterator++ )
+    for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        SEG currentSegment = *iterator;
-        int distance = currentSegment.Distance( aPoint );
+        const POLYGON& polygon = m_polys[polygonIdx];
 
-        // Check for collisions
-        if( distance <= aClearance )
+        if( index && index->IsIndexed( polygonIdx ) )
         {
-            collision = true;
+            index->Query( polygonIdx, area,
+                    [&]( int aContour, int aFirst, int aCount )
+                    {
+                        for( int ii = aFirst; ii < aFirst + aCount; ++ii )
+                            checkEdge( polygonIdx, aContour, ii, polygon[aContour].CSegment( ii ) );
 
-            // Update aClearance to look for closer edges
-            aClearance = distance;
+                        return true;
+                    } );
 
-            // Store the indices that identify the vertex
-            aClosestVertex = iterator.GetIndex();
+            continue;
+        }
+
+        for( size_t contour = 0; contour < polygon.size(); contour++ )
+        {
+            for( int ii = 0; ii < polygon[contour].SegmentCount(); ii++ )
+                checkEdge( polygonIdx, contour, ii, polygon[contour].CSegment( ii ) );
         }
     }
 
@@ -1408,10 +2030,9 @@ void SHAPE_POLY_SET::BuildBBoxCaches()
 {
     for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        Outline( polygonIdx ).GenerateBBoxCache();
-
-        for( int holeIdx = 0; holeIdx < HoleCount( polygonIdx ); holeIdx++ )
-            Hole( polygonIdx, holeIdx ).GenerateBBoxCache();
+        // The bounding box caches do not change the polygons, so the edge index stays valid
+        for( SHAPE_LINE_CHAIN& contour : m_polys[polygonIdx] )
+            contour.GenerateBBoxCache();
     }
 }
 
@@ -1422,14 +2043,16 @@ bool SHAPE_POLY_SET::Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccur
     if( m_polys.empty() )
         return false;
 
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
+
     // If there is a polygon specified, check the condition against that polygon
     if( aSubpolyIndex >= 0 )
-        return containsSingle( aP, aSubpolyIndex, aAccuracy, aUseBBoxCaches );
+        return containsSingle( aP, aSubpolyIndex, aAccuracy, aUseBBoxCaches, index.get() );
 
     // In any other case, check it against all polygons in the set
     for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        if( containsSingle( aP, polygonIdx, aAccuracy, aUseBBoxCaches ) )
+        if( containsSingle( aP, polygonIdx, aAccuracy, aUseBBoxCaches, index.get() ) )
             return true;
     }
 
@@ -1451,6 +2074,8 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
+    invalidateEdgeIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
 }
 
@@ -1468,13 +2093,18 @@ void SHAPE_POLY_SET::SetVertex( int aGlobalIndex, const VECTOR2I& aPos )
 
 void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos )
 {
+    invalidateEdgeIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].SetPoint( aIndex.m_vertex, aPos );
 }
 
 
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
-                                     bool aUseBBoxCaches ) const
+                                     bool aUseBBoxCaches, const EDGE_INDEX* aIndex ) const
 {
+    if( aIndex && aIndex->IsIndexed( aSubpolyIndex ) )
+        return aIndex->Contains( m_polys[aSubpolyIndex], aSubpolyIndex, aP, aAccuracy );
+
     // Check that the point is inside the outline
     if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy ) )
     {
@@ -1498,6 +2128,8 @@ bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int
 
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1508,6 +2140,8 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 
 void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1520,6 +2154,8 @@ void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_POLY_SET::Rotate( double aAngle, const VECTOR2I& aCenter )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1563,22 +2199,29 @@ int SHAPE_POLY_SET::DistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex )
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
     // the polygon.  Therefore test if a segment end is inside (testing only one end is enough).
     // Use an accuracy of "1" to say that we don't care if it's exactly on the edge or not.
-    if( containsSingle( aPoint, aPolygonIndex, 1 ) )
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
+
+    if( containsSingle( aPoint, aPolygonIndex, 1, false, index.get() ) )
         return 0;
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    if( index && index->IsIndexed( aPolygonIndex ) )
+    {
+        return index->MinDistance( m_polys[aPolygonIndex], aPolygonIndex,
+                                   EDGE_INDEX::AREA( aPoint ),
+                                   [&]( const SEG& aEdge )
+                                   {
+                                       return aEdge.Distance( aPoint );
+                                   } );
+    }
 
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aPoint );
+    int minDistance = std::numeric_limits<int>::max();
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    for( const SHAPE_LINE_CHAIN& contour : m_polys[aPolygonIndex] )
     {
-        polygonEdge = *iterator;
-
-        int currentDistance = polygonEdge.Distance( aPoint );
+        minDistance = std::min( minDistance, SEG_BATCH( contour ).Distance( aPoint ) );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+        if( minDistance == 0 )
+            break;
     }
 
     return minDistance;
@@ -1591,22 +2234,33 @@ int SHAPE_POLY_SET::DistanceToPolygon( const SEG& aSegment, int aPolygonIndex, i
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
     // the polygon.  Therefore test if a segment end is inside (testing only one end is enough).
     // Use an accuracy of "1" to say that we don't care if it's exactly on the edge or not.
-    if( containsSingle( aSegment.A, aPolygonIndex, 1 ) )
-        return 0;
+    std::shared_ptr<const EDGE_INDEX> index = edgeIndex();
 
-    SEGMENT_ITERATOR iterator = IterateSegmentsWithHoles( aPolygonIndex );
+    if( containsSingle( aSegment.A, aPolygonIndex, 1, false, index.get() ) )
+        return 0;
 
-    SEG polygonEdge = *iterator;
-    int minDistance = polygonEdge.Distance( aSegment );
+    int minDistance;
 
-    for( iterator++; iterator && minDistance > 0; iterator++ )
+    if( index && index->IsIndexed( aPolygonIndex ) )
+    {
+        minDistance = index->MinDistance( m_polys[aPolygonIndex], aPolygonIndex,
+                                          EDGE_INDEX::AREA( aSegment ),
+                                          [&]( const SEG& aEdge )
+                                          {
+                                              return aEdge.Distance( aSegment );
+                                          } );
+    }
+    else
     {
-        polygonEdge = *iterator;
+        minDistance = std::numeric_limits<int>::max();
 
-        int currentDistance = polygonEdge.Distance( aSegment );
+        for( const SHAPE_LINE_CHAIN& contour : m_polys[aPolygonIndex] )
+        {
+            minDistance = std::min( minDistance, SEG_BATCH( contour ).Distance( aSegment ) );
 
-        if( currentDistance < minDistance )
-            minDistance = currentDistance;
+            if( minDistance == 0 )
+                break;
+        }
     }
 
     // Take into account the width of the segment
@@ -1697,7 +2351,7 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::chamferFilletPolygon( CORNER_MODE aMode,
     // Null segments create serious issues in calculations. Remove them:
     RemoveNullSegments();
 
-    SHAPE_POLY_SET::POLYGON currentPoly = Polygon( aIndex );
+    SHAPE_POLY_SET::POLYGON currentPoly = m_polys[aIndex];
     SHAPE_POLY_SET::POLYGON newPoly;
 
     // If the chamfering distance is zero, then the polygon remain intact.
@@ -1863,10 +2517,33 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
 
-    // reset poly cache:
-    m_hash = MD5_HASH{};
-    m_triangulationValid = false;
-    m_triangulatedPolys.clear();
+    // reset poly cache, or share the other one's if it is still valid:
+    if( aOther.IsTriangulationUpToDate() )
+    {
+        m_hash = aOther.GetHash();
+        m_triangulationValid = true;
+        m_triangulatedPolys = aOther.m_triangulatedPolys;
+    }
+    else
+    {
+        m_hash = MD5_HASH{};
+        m_triangulationValid = false;
+        m_triangulatedPolys.clear();
+    }
+
+    // The other set's edge index is valid for the copied polygons, unless they have been
+    // exposed and it is stale
+    if( aOther.m_polysExposed )
+    {
+        resetEdgeIndex();
+    }
+    else
+    {
+        std::atomic_store( &m_edgeIndex, std::atomic_load( &aOther.m_edgeIndex ) );
+        m_edgeIndexQueries.store( aOther.m_edgeIndexQueries.load( std::memory_order_relaxed ),
+                                  std::memory_order_relaxed );
+    }
+
     return *this;
 }
 
@@ -1893,7 +2570,7 @@ bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 }
 
 
-void SHAPE_POLY_SET::CacheTriangulation()
+void SHAPE_POLY_SET::CacheTriangulation( bool aParallel )
 {
     bool recalculate = !m_hash.IsValid();
     MD5_HASH hash;
@@ -1920,30 +2597,94 @@ void SHAPE_POLY_SET::CacheTriangulation()
     if( tmpSet.HasHoles() )
         tmpSet.Fracture( PM_FAST );
 
+    SHAPE_POLY_SET failed;
+
     m_triangulatedPolys.clear();
-    m_triangulationValid = true;
+    triangulateOutlines( tmpSet, m_triangulatedPolys, failed, aParallel );
 
-    while( tmpSet.OutlineCount() > 0 )
+    // If the tesselation fails, we re-fracture the polygon, which will
+    // first simplify the system before fracturing and removing the holes
+    // This may result in multiple, disjoint polygons.
+    if( failed.OutlineCount() > 0 )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        failed.Fracture( PM_FAST );
+        tmpSet = failed;
+        failed.RemoveAllContours();
+        triangulateOutlines( tmpSet, m_triangulatedPolys, failed, aParallel );
+    }
+
+    m_triangulationValid = failed.OutlineCount() == 0;
+
+    if( m_triangulationValid )
+        m_hash = checksum();
+}
+
 
-        // If the tesselation fails, we re-fracture the polygon, which will
-        // first simplify the system before fracturing and removing the holes
-        // This may result in multiple, disjoint polygons.
-        if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
+void SHAPE_POLY_SET::triangulateOutlines( const SHAPE_POLY_SET& aPolys,
+        std::vector<std::shared_ptr<TRIANGULATED_POLYGON>>& aResult, SHAPE_POLY_SET& aFailed,
+        bool aParallel )
+{
+    // Below this size, starting the threads costs more than triangulating the outlines
+    const int MIN_PARALLEL_VERTICES = 4096;
+
+    size_t count = aPolys.OutlineCount();
+    std::vector<std::shared_ptr<TRIANGULATED_POLYGON>> results( count );
+
+    // Hand out the largest outlines first, so no thread is left alone with a large one
+    // at the end
+    std::vector<int> order( count );
+
+    for( size_t ii = 0; ii < count; ++ii )
+        order[ii] = ii;
+
+    std::sort( order.begin(), order.end(),
+               [&aPolys]( int aA, int aB )
+               {
+                   return aPolys.COutline( aA ).PointCount() > aPolys.COutline( aB ).PointCount();
+               } );
+
+    std::atomic<size_t> next( 0 );
+
+    auto triangulate = [&]()
+    {
+        for( size_t i = next.fetch_add( 1 ); i < count; i = next.fetch_add( 1 ) )
         {
-            tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
-            continue;
+            auto                 triPoly = std::make_shared<TRIANGULATED_POLYGON>();
+            PolygonTriangulation tess( *triPoly );
+
+            if( tess.TesselatePolygon( aPolys.COutline( order[i] ) ) )
+                results[order[i]] = std::move( triPoly );
         }
+    };
 
-        tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
+    size_t threadCount = 1;
+
+    if( aParallel && count > 1 && aPolys.TotalVertices() >= MIN_PARALLEL_VERTICES )
+    {
+        threadCount = std::min<size_t>( std::max<size_t>( std::thread::hardware_concurrency(), 1 ),
+                                        count );
     }
 
-    if( m_triangulationValid )
-        m_hash = checksum();
+    // The calling thread does its share of the work too
+    std::vector<std::future<void>> returns;
+
+    for( size_t ii = 1; ii < threadCount; ++ii )
+        returns.emplace_back( std::async( std::launch::async, triangulate ) );
+
+    triangulate();
+
+    for( auto& ret : returns )
+        ret.get();
+
+    // Keep the triangulated polygons in the order of the outlines, whatever the thread which
+    // built them
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        if( results[ii] )
+            aResult.push_back( std::move( results[ii] ) );
+        else
+            aFailed.AddOutline( aPolys.COutline( ii ) );
+    }
 }
 
 
@@ -118,6 +118,61 @@ std::string MD5_HASH::Format()
 }
 
 
+std::string MD5_HASH::ToHexString() const
+{
+    static const char digits[] = "0123456789abcdef";
+
+    std::string data;
+
+    for( int ii = 0; ii < 16; ++ii )
+    {
+        data += digits[( m_hash[ii] >> 4 ) & 0x0F];
+        data += digits[m_hash[ii] & 0x0F];
+    }
+
+    return data;
+}
+
+
+bool MD5_HASH::FromHexString( const std::string& aHex )
+{
+    auto nibble = []( char c ) -> int
+    {
+        if( c >= '0' && c <= '9' )
+            return c - '0';
+        else if( c >= 'a' && c <= 'f' )
+            return c - 'a' + 10;
+        else if( c >= 'A' && c <= 'F' )
+            return c - 'A' + 10;
+
+        return -1;
+    };
+
+    Init();
+
+    if( aHex.size() != 32 )
+        return false;
+
+    uint8_t hash[16];
+
+    for( int ii = 0; ii < 16; ++ii )
+    {
+        int msb = nibble( aHex[2 * ii] );
+        int lsb = nibble( aHex[2 * ii + 1] );
+
+        if( msb < 0 || lsb < 0 )
+            return false;
+
+        hash[ii] = (uint8_t) ( ( msb << 4 ) | lsb );
+    }
+
+    memcpy( m_hash, hash, 16 );
+    m_valid = true;
+
+    return true;
+}
+
+
 void MD5_HASH::md5_transform(MD5_CTX *ctx, uint8_t data[])
 {
    uint32_t a,b,c,d,m[16],i,j;
@@ -45,7 +45,10 @@
 #include "ar_autoplacer.h"
 #include "ar_cell.h"
 #include "ar_matrix.h"
+#include <atomic>
+#include <future>
 #include <memory>
+#include <thread>
 
 #define AR_GAIN            16
 #define AR_KEEPOUT_MARGIN  500
@@ -468,21 +471,12 @@ int AR_AUTOPLACER::testRectangle( const EDA_RECT& aRect, int side )
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    for( int row = row_min; row <= row_max; row++ )
+    switch( m_matrix.TestPlacementRect( row_min, row_max, col_min, col_max, side ) )
     {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            unsigned int data = m_matrix.GetCell( row, col, side );
-
-            if( ( data & CELL_IS_ZONE ) == 0 )
-                return AR_OUT_OF_BOARD;
-
-            if( (data & CELL_IS_MODULE) )
-                return AR_OCCUIPED_BY_MODULE;
-        }
+    case CELL_IS_ZONE:   return AR_OUT_OF_BOARD;
+    case CELL_IS_MODULE: return AR_OCCUIPED_BY_MODULE;
+    default:             return AR_FREE_CELL;
     }
-
-    return AR_FREE_CELL;
 }
 
 int AR_AUTOPLACER::testModuleByPolygon( MODULE* aModule, int aSide, const wxPoint& aOffset )
@@ -537,21 +531,9 @@ unsigned int AR_AUTOPLACER::calculateKeepOutArea( const EDA_RECT& aRect, int sid
     if( col_max >= ( m_matrix.m_Ncols - 1 ) )
         col_max = m_matrix.m_Ncols - 1;
 
-    unsigned int keepOutCost = 0;
-
-    for( int row = row_min; row <= row_max; row++ )
-    {
-        for( int col = col_min; col <= col_max; col++ )
-        {
-            // m_matrix.GetDist returns the "cost" of the cell
-            // at position (row, col)
-            // in autoplace this is the cost of the cell, if it is
-            // inside aRect
-            keepOutCost += m_matrix.GetDist( row, col, side );
-        }
-    }
-
-    return keepOutCost;
+    // The distance cells hold the "cost" of each cell in autoplace: the clearance area is
+    // the sum of the cells inside aRect, read from the matrix summed area table
+    return (unsigned int) m_matrix.GetDistSum( row_min, row_max, col_min, col_max, side );
 }
 
 
@@ -572,8 +554,6 @@ int AR_AUTOPLACER::testModuleOnBoard( MODULE* aModule, bool TstOtherSide, const
     EDA_RECT    fpBBox = aModule->GetFootprintRect();
     fpBBox.Move( -aOffset );
 
-    buildFpAreas( aModule, 0 );
-
     int diag = //testModuleByPolygon( aModule, side, aOffset );
         testRectangle( fpBBox, side );
 //printf("test %p diag %d\n", aModule, diag);fflush(0);
@@ -600,7 +580,7 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
 {
     int     error = 1;
     wxPoint LastPosOK;
-    double  min_cost, curr_cost, Score;
+    double  min_cost, Score;
     bool    TstOtherSide;
 
     aModule->CalculateBoundingBox();
@@ -625,7 +605,6 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
     initialPos.y    -= initialPos.y % m_matrix.m_GridRouting;
 
     m_curPosition = initialPos;
-    auto moduleOffset = mod_pos - m_curPosition;
 
     /* Examine pads, and set TstOtherSide to true if a footprint
      * has at least 1 pad through.
@@ -646,42 +625,79 @@ int AR_AUTOPLACER::getOptimalModulePlacement(MODULE* aModule)
         }
     }
 
-    fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-
-    min_cost = -1.0;
-//    m_frame->SetStatusText( wxT( "Score ??, pos ??" ) );
+    // The candidate positions are evaluated in parallel from a snapshot of the matrix.
+    m_matrix.BuildPlacementMaps();
+    buildFpAreas( aModule, 0 );
 
+    std::vector<wxPoint> candidates;
 
     for( ; m_curPosition.x < xylimit.x; m_curPosition.x += m_matrix.m_GridRouting )
     {
         m_curPosition.y = initialPos.y;
 
         for( ; m_curPosition.y < xylimit.y; m_curPosition.y += m_matrix.m_GridRouting )
-        {
+            candidates.push_back( m_curPosition );
+    }
 
-            fpBBox.SetOrigin( fpBBoxOrg + m_curPosition );
-            moduleOffset = mod_pos - m_curPosition;
-            int keepOutCost = testModuleOnBoard( aModule, TstOtherSide, moduleOffset );
+    // A negative score means the footprint cannot be put at this position
+    std::vector<double> scores( candidates.size(), -1.0 );
+    std::atomic<size_t> nextItem( 0 );
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   candidates.size() );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto score_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextItem.fetch_add( 1 ); i < candidates.size();
+             i = nextItem.fetch_add( 1 ) )
+        {
+            wxPoint offset = mod_pos - candidates[i];
+            int     keepOutCost = testModuleOnBoard( aModule, TstOtherSide, offset );
 
             if( keepOutCost >= 0 )    // i.e. if the module can be put here
-            {
-                error = 0;
-                // m_frame->build_ratsnest_module( aModule ); // fixme
-                curr_cost   = computePlacementRatsnestCost( aModule, moduleOffset );
-                Score       = curr_cost + keepOutCost;
-
-                if( (min_cost >= Score ) || (min_cost < 0 ) )
-                {
-                    LastPosOK   = m_curPosition;
-                    min_cost    = Score;
-                    wxString msg;
-/*                    msg.Printf( wxT( "Score %g, pos %s, %s" ),
-                                min_cost,
-                                GetChars( ::CoordinateToString( LastPosOK.x ) ),
-                                GetChars( ::CoordinateToString( LastPosOK.y ) ) );
-                    m_frame->SetStatusText( msg );*/
-                }
-            }
+                scores[i] = computePlacementRatsnestCost( aModule, offset ) + keepOutCost;
+
+            num++;
+        }
+
+        return num;
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, score_lambda );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        // Here we balance returns with a 100ms timeout to allow UI updating
+        std::future_status status;
+        do
+        {
+            if( m_progressReporter )
+                m_progressReporter->KeepRefreshing();
+
+            status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+        } while( status != std::future_status::ready );
+    }
+
+    min_cost = -1.0;
+
+    // Keep the scan order when selecting the best score, so that the result does not depend
+    // on the number of threads
+    for( size_t i = 0; i < candidates.size(); i++ )
+    {
+        Score = scores[i];
+
+        if( Score < 0 )
+            continue;
+
+        error = 0;
+
+        if( ( min_cost >= Score ) || ( min_cost < 0 ) )
+        {
+            LastPosOK   = candidates[i];
+            min_cost    = Score;
         }
     }
 
@@ -55,6 +55,7 @@ AR_MATRIX::AR_MATRIX()
     m_RouteCount         = 0;
     m_routeLayerBottom   = B_Cu;
     m_routeLayerTop      = F_Cu;
+    m_maskStride         = 0;
 }
 
 
@@ -173,7 +174,15 @@ void AR_MATRIX::UnInitRoutingMatrix()
         }
     }
 
+    for( ii = 0; ii < AR_MAX_ROUTING_LAYERS_COUNT; ii++ )
+    {
+        m_zoneMask[ii].clear();
+        m_moduleMask[ii].clear();
+        m_distSum[ii].clear();
+    }
+
     m_Nrows = m_Ncols = 0;
+    m_maskStride = 0;
 }
 
 // Initialize m_opWriteCell member to make the aLogicOp
@@ -195,6 +204,167 @@ void AR_MATRIX::SetCellOperation( AR_MATRIX::CELL_OP aLogicOp )
 }
 
 
+static const int MASK_BITS = 64;
+
+
+void AR_MATRIX::fillMaskSpan( MASK_WORD* aRow, int aColStart, int aColEnd )
+{
+    int       first = aColStart / MASK_BITS;
+    int       last = aColEnd / MASK_BITS;
+    MASK_WORD head = ~MASK_WORD( 0 ) << ( aColStart % MASK_BITS );
+    MASK_WORD tail = ~MASK_WORD( 0 ) >> ( MASK_BITS - 1 - aColEnd % MASK_BITS );
+
+    if( first == last )
+    {
+        aRow[first] |= head & tail;
+        return;
+    }
+
+    aRow[first] |= head;
+
+    for( int ii = first + 1; ii < last; ii++ )
+        aRow[ii] = ~MASK_WORD( 0 );
+
+    aRow[last] |= tail;
+}
+
+
+int AR_MATRIX::findMaskBit( const MASK_WORD* aRow, int aColMin, int aColMax, bool aSet )
+{
+    if( aColMin > aColMax )
+        return -1;
+
+    int first = aColMin / MASK_BITS;
+    int last = aColMax / MASK_BITS;
+
+    for( int ii = first; ii <= last; ii++ )
+    {
+        MASK_WORD bits = aSet ? aRow[ii] : ~aRow[ii];
+
+        if( ii == first )
+            bits &= ~MASK_WORD( 0 ) << ( aColMin % MASK_BITS );
+
+        if( ii == last )
+            bits &= ~MASK_WORD( 0 ) >> ( MASK_BITS - 1 - aColMax % MASK_BITS );
+
+        if( bits )
+        {
+            int col = ii * MASK_BITS;
+
+            while( !( bits & 1 ) )
+            {
+                bits >>= 1;
+                col++;
+            }
+
+            return col;
+        }
+    }
+
+    return -1;
+}
+
+
+void AR_MATRIX::BuildPlacementMaps()
+{
+    m_maskStride = ( m_Ncols + MASK_BITS - 1 ) / MASK_BITS;
+
+    for( int side = 0; side < AR_MAX_ROUTING_LAYERS_COUNT; side++ )
+    {
+        if( !m_BoardSide[side] || !m_DistSide[side] )
+        {
+            m_zoneMask[side].clear();
+            m_moduleMask[side].clear();
+            m_distSum[side].clear();
+            continue;
+        }
+
+        m_zoneMask[side].assign( (size_t) m_Nrows * m_maskStride, 0 );
+        m_moduleMask[side].assign( (size_t) m_Nrows * m_maskStride, 0 );
+        m_distSum[side].assign( (size_t) ( m_Nrows + 1 ) * ( m_Ncols + 1 ), 0 );
+
+        for( int row = 0; row < m_Nrows; row++ )
+        {
+            const MATRIX_CELL* cells = m_BoardSide[side] + row * m_Ncols;
+            const DIST_CELL*   dist = m_DistSide[side] + row * m_Ncols;
+            MASK_WORD*         zoneRow = &m_zoneMask[side][row * m_maskStride];
+            MASK_WORD*         moduleRow = &m_moduleMask[side][row * m_maskStride];
+
+            // Runs of flagged cells are filled a word at a time
+            for( MATRIX_CELL flag : { CELL_IS_ZONE, CELL_IS_MODULE } )
+            {
+                MASK_WORD* maskRow = flag == CELL_IS_ZONE ? zoneRow : moduleRow;
+
+                for( int col = 0; col < m_Ncols; col++ )
+                {
+                    if( !( cells[col] & flag ) )
+                        continue;
+
+                    int end = col;
+
+                    while( end + 1 < m_Ncols && ( cells[end + 1] & flag ) )
+                        end++;
+
+                    fillMaskSpan( maskRow, col, end );
+                    col = end;
+                }
+            }
+
+            const int64_t* above = &m_distSum[side][row * ( m_Ncols + 1 )];
+            int64_t*       sum = &m_distSum[side][( row + 1 ) * ( m_Ncols + 1 )];
+            int64_t        rowSum = 0;
+
+            for( int col = 0; col < m_Ncols; col++ )
+            {
+                rowSum += dist[col];
+                sum[col + 1] = above[col + 1] + rowSum;
+            }
+        }
+    }
+}
+
+
+int AR_MATRIX::TestPlacementRect( int aRowMin, int aRowMax, int aColMin, int aColMax,
+                                  int aSide ) const
+{
+    if( aColMin > aColMax )
+        return 0;
+
+    for( int row = aRowMin; row <= aRowMax; row++ )
+    {
+        const MASK_WORD* zoneRow = &m_zoneMask[aSide][row * m_maskStride];
+        const MASK_WORD* moduleRow = &m_moduleMask[aSide][row * m_maskStride];
+
+        int outside = findMaskBit( zoneRow, aColMin, aColMax, false );
+        int used = findMaskBit( moduleRow, aColMin, aColMax, true );
+
+        if( outside < 0 && used < 0 )
+            continue;
+
+        if( used < 0 || ( outside >= 0 && outside <= used ) )
+            return CELL_IS_ZONE;
+
+        return CELL_IS_MODULE;
+    }
+
+    return 0;
+}
+
+
+int64_t AR_MATRIX::GetDistSum( int aRowMin, int aRowMax, int aColMin, int aColMax,
+                               int aSide ) const
+{
+    if( aRowMin > aRowMax || aColMin > aColMax )
+        return 0;
+
+    const std::vector<int64_t>& sum = m_distSum[aSide];
+    int                         stride = m_Ncols + 1;
+
+    return sum[( aRowMax + 1 ) * stride + aColMax + 1] - sum[aRowMin * stride + aColMax + 1]
+           - sum[( aRowMax + 1 ) * stride + aColMin] + sum[aRowMin * stride + aColMin];
+}
+
+
 /* return the value stored in a cell
  */
 AR_MATRIX::MATRIX_CELL AR_MATRIX::GetCell( int aRow, int aCol, int aSide )
@@ -32,6 +32,9 @@
 #include <eda_rect.h>
 #include <layers_id_colors_and_visibility.h>
 
+#include <cstdint>
+#include <vector>
+
 class DRAWSEGMENT;
 class TRACK;
 class D_PAD;
@@ -73,6 +76,16 @@ private:
     // a pointer to the current selected cell operation
     void ( AR_MATRIX::*m_opWriteCell )( int aRow, int aCol, int aSide, MATRIX_CELL aCell );
 
+    typedef uint64_t MASK_WORD;
+
+    // Placement maps, see BuildPlacementMaps(): one bit per cell for the CELL_IS_ZONE and
+    // CELL_IS_MODULE flags, m_maskStride words per row, and a (m_Nrows + 1) x (m_Ncols + 1)
+    // summed area table of the distance cells.
+    int                    m_maskStride;
+    std::vector<MASK_WORD> m_zoneMask[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<MASK_WORD> m_moduleMask[AR_MAX_ROUTING_LAYERS_COUNT];
+    std::vector<int64_t>   m_distSum[AR_MAX_ROUTING_LAYERS_COUNT];
+
 public:
     enum CELL_OP
     {
@@ -136,6 +149,31 @@ public:
     int         GetDir( int aRow, int aCol, int aSide );
     void        SetDir( int aRow, int aCol, int aSide, int aDir );
 
+    /**
+     * Function BuildPlacementMaps
+     * builds the bit-packed copies of the CELL_IS_ZONE and CELL_IS_MODULE flags and the
+     * summed area table of the distance cells used by TestPlacementRect() and GetDistSum().
+     * The maps are a snapshot: they must be rebuilt after the matrix has been modified.
+     */
+    void BuildPlacementMaps();
+
+    /**
+     * Function TestPlacementRect
+     * tests the cells of a rectangle (bounds included) of one side against the placement
+     * maps, a whole row span at a time.  Cells are examined in row order, like a cell by
+     * cell scan would do.
+     * @return 0 if all cells are inside the board and free, CELL_IS_ZONE if the first
+     * offending cell is outside the board or CELL_IS_MODULE if it is used by a footprint.
+     */
+    int TestPlacementRect( int aRowMin, int aRowMax, int aColMin, int aColMax, int aSide ) const;
+
+    /**
+     * Function GetDistSum
+     * @return the sum of the distance cells of a rectangle (bounds included) of one side,
+     * from the summed area table.
+     */
+    int64_t GetDistSum( int aRowMin, int aRowMax, int aColMin, int aColMax, int aSide ) const;
+
     // calculate distance (with penalty) of a trace through a cell
     int CalcDist( int x, int y, int z, int side );
 
@@ -154,6 +192,12 @@ public:
             AR_MATRIX::CELL_OP op_logic );
 
 private:
+    // set the bits aColStart to aColEnd (included) of a mask row
+    static void fillMaskSpan( MASK_WORD* aRow, int aColStart, int aColEnd );
+
+    // @return the first column between aColMin and aColMax (included) whose bit is set
+    // (aSet = true) or cleared (aSet = false) in a mask row, or -1
+    static int findMaskBit( const MASK_WORD* aRow, int aColMin, int aColMax, bool aSet );
 
     void drawSegmentQcq( int ux0, int uy0, int ux1, int uy1, int lg, LAYER_NUM layer, int color,
             CELL_OP op_logic );
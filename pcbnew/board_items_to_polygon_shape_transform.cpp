@@ -247,7 +247,7 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet( SHAPE_POLY_SET& aCor
         return;
 
     // add filled areas polygons
-    aCornerBuffer.Append( m_FilledPolysList );
+    aCornerBuffer.Append( *m_FilledPolysList );
     auto board = GetBoard();
     int maxError = ARC_HIGH_DEF;
 
@@ -255,9 +255,9 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet( SHAPE_POLY_SET& aCor
         maxError = board->GetDesignSettings().m_MaxError;
 
     // add filled areas outlines, which are drawn with thick lines
-    for( int i = 0; i < m_FilledPolysList.OutlineCount(); i++ )
+    for( int i = 0; i < m_FilledPolysList->OutlineCount(); i++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( i );
+        const SHAPE_LINE_CHAIN& path = m_FilledPolysList->COutline( i );
 
         for( int j = 0; j < path.PointCount(); j++ )
         {
@@ -716,6 +716,6 @@ void ZONE_CONTAINER::TransformShapeWithClearanceToPolygon( SHAPE_POLY_SET& aCorn
 {
     wxASSERT_MSG( !ignoreLineWidth, "IgnoreLineWidth has no meaning for zones." );
 
-    aCornerBuffer = m_FilledPolysList;
+    aCornerBuffer = *m_FilledPolysList;
     aCornerBuffer.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 }
@@ -71,6 +71,9 @@ ZONE_CONTAINER::ZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent, bool aInModule )
     m_cornerRadius = 0;
     SetLocalFlags( 0 );                         // flags tempoarry used in zone calculations
     m_Poly = new SHAPE_POLY_SET();              // Outlines
+    m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
+    m_RawPolysList = std::make_shared<SHAPE_POLY_SET>();
+    m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>();
     m_FilledPolysUseThickness = true;           // set the "old" way to build filled polygon areas (before 6.0.x)
     aParent->GetZoneSettings().ExportSetting( *this );
 
@@ -105,10 +108,10 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     SetHatchStyle( aOther.GetHatchStyle() );
     SetHatchPitch( aOther.GetHatchPitch() );
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.Append( aOther.m_FilledPolysList );
-    m_FillSegmList.clear();
+    m_FilledPolysList = aOther.m_FilledPolysList;   // shared until one of us is modified
+    m_RawPolysList = aOther.m_RawPolysList;
     m_FillSegmList = aOther.m_FillSegmList;
+    m_fillInputsHash = aOther.m_fillInputsHash;
 
     m_HatchFillTypeThickness = aOther.m_HatchFillTypeThickness;
     m_HatchFillTypeGap = aOther.m_HatchFillTypeGap;
@@ -156,8 +159,10 @@ void ZONE_CONTAINER::initDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone )
     m_PadConnection = aZone.m_PadConnection;
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
-    m_FilledPolysList.Append( aZone.m_FilledPolysList );
-    m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
+    m_FilledPolysList = aZone.m_FilledPolysList;    // shared until one of us is modified
+    m_RawPolysList = aZone.m_RawPolysList;
+    m_FillSegmList = aZone.m_FillSegmList;
+    m_fillInputsHash = aZone.m_fillInputsHash;
 
     m_doNotAllowCopperPour = aZone.m_doNotAllowCopperPour;
     m_doNotAllowVias = aZone.m_doNotAllowVias;
@@ -196,11 +201,12 @@ EDA_ITEM* ZONE_CONTAINER::Clone() const
 
 bool ZONE_CONTAINER::UnFill()
 {
-    bool change = ( !m_FilledPolysList.IsEmpty() || m_FillSegmList.size() > 0 );
+    bool change = ( !m_FilledPolysList->IsEmpty() || m_FillSegmList->size() > 0 );
 
-    m_FilledPolysList.RemoveAllContours();
-    m_FillSegmList.clear();
+    m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
+    m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>();
     m_IsFilled = false;
+    m_fillInputsHash.SetValid( false );
 
     return change;
 }
@@ -481,7 +487,7 @@ int ZONE_CONTAINER::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 
 bool ZONE_CONTAINER::HitTestFilledArea( const wxPoint& aRefPos ) const
 {
-    return m_FilledPolysList.Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
+    return m_FilledPolysList->Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
 }
 
 
@@ -592,9 +598,9 @@ void ZONE_CONTAINER::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANEL_IT
     msg.Printf( wxT( "%d" ), (int) m_HatchLines.size() );
     aList.emplace_back( MSG_PANEL_ITEM( _( "Hatch Lines" ), msg, BLUE ) );
 
-    if( !m_FilledPolysList.IsEmpty() )
+    if( !m_FilledPolysList->IsEmpty() )
     {
-        msg.Printf( wxT( "%d" ), m_FilledPolysList.TotalVertices() );
+        msg.Printf( wxT( "%d" ), m_FilledPolysList->TotalVertices() );
         aList.emplace_back( MSG_PANEL_ITEM( _( "Corner Count" ), msg, BLUE ) );
     }
 }
@@ -609,9 +615,9 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     Hatch();
 
-    m_FilledPolysList.Move( offset );
+    detach( m_FilledPolysList ).Move( offset );
 
-    for( SEG& seg : m_FillSegmList )
+    for( SEG& seg : detach( m_FillSegmList ) )
     {
         seg.A += VECTOR2I( offset );
         seg.B += VECTOR2I( offset );
@@ -644,16 +650,16 @@ void ZONE_CONTAINER::Rotate( const wxPoint& centre, double angle )
     Hatch();
 
     /* rotate filled areas: */
-    m_FilledPolysList.Rotate( angle, VECTOR2I( centre ) );
+    detach( m_FilledPolysList ).Rotate( angle, VECTOR2I( centre ) );
 
-    for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
+    for( SEG& seg : detach( m_FillSegmList ) )
     {
-        wxPoint a( m_FillSegmList[ic].A );
+        wxPoint a( seg.A );
         RotatePoint( &a, centre, angle );
-        m_FillSegmList[ic].A = a;
-        wxPoint b( m_FillSegmList[ic].B );
+        seg.A = a;
+        wxPoint b( seg.B );
         RotatePoint( &b, centre, angle );
-        m_FillSegmList[ic].B = a;
+        seg.B = a;
     }
 }
 
@@ -681,9 +687,10 @@ void ZONE_CONTAINER::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 
     Hatch();
 
-    m_FilledPolysList.Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
+    detach( m_FilledPolysList ).Mirror( aMirrorLeftRight, !aMirrorLeftRight,
+                                        VECTOR2I( aMirrorRef ) );
 
-    for( SEG& seg : m_FillSegmList )
+    for( SEG& seg : detach( m_FillSegmList ) )
     {
         if( aMirrorLeftRight )
         {
@@ -1012,9 +1019,14 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 }
 
 
-void ZONE_CONTAINER::CacheTriangulation()
+void ZONE_CONTAINER::CacheTriangulation( bool aParallel )
 {
-    m_FilledPolysList.CacheTriangulation();
+    // The triangulation cache lives in the polygon set, so a shared fill must not be
+    // triangulated in place (copies of this zone may be triangulated from other threads)
+    if( m_FilledPolysList->IsTriangulationUpToDate() )
+        return;
+
+    detach( m_FilledPolysList ).CacheTriangulation( aParallel );
 }
 
 
@@ -1110,13 +1122,13 @@ double ZONE_CONTAINER::CalculateFilledArea()
 
     // Iterate over each outline polygon in the zone and then iterate over
     // each hole it has to compute the total area.
-    for( int i = 0; i < m_FilledPolysList.OutlineCount(); i++ )
+    for( int i = 0; i < m_FilledPolysList->OutlineCount(); i++ )
     {
-        m_area += m_FilledPolysList.Outline( i ).Area();
+        m_area += m_FilledPolysList->COutline( i ).Area();
 
-        for( int j = 0; j < m_FilledPolysList.HoleCount( i ); j++ )
+        for( int j = 0; j < m_FilledPolysList->HoleCount( i ); j++ )
         {
-            m_area -= m_FilledPolysList.Hole( i, j ).Area();
+            m_area -= m_FilledPolysList->CHole( i, j ).Area();
         }
     }
 
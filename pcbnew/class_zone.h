@@ -30,6 +30,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <memory>
 #include <vector>
 #include <gr_basic.h>
 #include <class_board_item.h>
@@ -239,8 +240,8 @@ public:
     int GetLocalFlags() const { return m_localFlgs; }
     void SetLocalFlags( int aFlags ) { m_localFlgs = aFlags; }
 
-    ZONE_SEGMENT_FILL& FillSegments() { return m_FillSegmList; }
-    const ZONE_SEGMENT_FILL& FillSegments() const { return m_FillSegmList; }
+    ZONE_SEGMENT_FILL& FillSegments() { return detach( m_FillSegmList ); }
+    const ZONE_SEGMENT_FILL& FillSegments() const { return *m_FillSegmList; }
 
     SHAPE_POLY_SET* Outline() { return m_Poly; }
     const SHAPE_POLY_SET* Outline() const { return const_cast< SHAPE_POLY_SET* >( m_Poly ); }
@@ -558,7 +559,7 @@ public:
      */
     void ClearFilledPolysList()
     {
-        m_FilledPolysList.RemoveAllContours();
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
     }
 
    /**
@@ -568,13 +569,15 @@ public:
      */
     const SHAPE_POLY_SET& GetFilledPolysList() const
     {
-        return m_FilledPolysList;
+        return *m_FilledPolysList;
     }
 
     /** (re)create a list of triangles that "fill" the solid areas.
      * used for instance to draw these solid areas on opengl
+     * @param aParallel is false when several zones are triangulated concurrently, so large
+     * fills are not spread over more threads.
      */
-    void CacheTriangulation();
+    void CacheTriangulation( bool aParallel = true );
 
    /**
      * Function SetFilledPolysList
@@ -582,7 +585,7 @@ public:
      */
     void SetFilledPolysList( SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList = aPolysList;
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
     /**
@@ -591,7 +594,7 @@ public:
       */
     void SetRawPolysList( SHAPE_POLY_SET& aPolysList )
     {
-        m_RawPolysList = aPolysList;
+        m_RawPolysList = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
 
@@ -635,12 +638,12 @@ public:
 
     void SetFillSegments( const ZONE_SEGMENT_FILL& aSegments )
     {
-        m_FillSegmList = aSegments;
+        m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>( aSegments );
     }
 
     SHAPE_POLY_SET& RawPolysList()
     {
-        return m_RawPolysList;
+        return detach( m_RawPolysList );
     }
 
     wxString GetSelectMenuText( EDA_UNITS aUnits ) const override;
@@ -723,7 +726,16 @@ public:
      *  in m_filledPolysHash.
      *  Used in zone filling calculations, to know if m_FilledPolysList is up to date.
      */
-    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList.GetHash(); }
+    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList->GetHash(); }
+
+    /**
+     * @return the hash of the inputs of the zone filler (outline, settings and the items
+     * around the zone) the current fill was built from.  Invalid if the zone is not filled,
+     * or was filled by a version of the filler which did not record it.
+     * See ZONE_FILLER::computeFillInputsHashes().
+     */
+    const MD5_HASH& GetFillInputsHash() const { return m_fillInputsHash; }
+    void SetFillInputsHash( const MD5_HASH& aHash ) { m_fillInputsHash = aHash; }
 
 
 
@@ -740,6 +752,23 @@ protected:
      */
     void initDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone );
 
+    /**
+     * Copy-on-write access to the fill data.
+     *
+     * The fill data (which can be very large) is shared between a zone and its copies,
+     * for instance the copies kept in the undo/redo lists.  It is only duplicated when
+     * one of them is about to be modified.
+     * @return a reference to a copy of the fill data owned by this zone only.
+     */
+    template <typename T>
+    static T& detach( std::shared_ptr<T>& aData )
+    {
+        if( aData.use_count() > 1 )
+            aData = std::make_shared<T>( *aData );
+
+        return *aData;
+    }
+
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
     unsigned int          m_cornerRadius;
@@ -817,7 +846,7 @@ protected:
     /** Segments used to fill the zone (#m_FillMode ==1 ), when fill zone by segment is used.
      *  In this case the segments have #m_ZoneMinThickness width.
      */
-    ZONE_SEGMENT_FILL          m_FillSegmList;
+    std::shared_ptr<ZONE_SEGMENT_FILL> m_FillSegmList;
 
     /* set of filled polygons used to draw a zone as a filled area.
      * from outlines (m_Poly) but unlike m_Poly these filled polygons have no hole
@@ -826,11 +855,14 @@ protected:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     * The filled polygons are shared with copies of the zone (see detach()).
      */
-    SHAPE_POLY_SET        m_FilledPolysList;
-    SHAPE_POLY_SET        m_RawPolysList;
+    std::shared_ptr<SHAPE_POLY_SET> m_FilledPolysList;
+    std::shared_ptr<SHAPE_POLY_SET> m_RawPolysList;
     MD5_HASH              m_filledPolysHash;    // A hash value used in zone filling calculations
                                                 // to see if the filled areas are up to date
+    MD5_HASH              m_fillInputsHash;     // The hash of the filler inputs the filled
+                                                // areas were built from
 
     ZONE_HATCH_STYLE      m_hatchStyle;     // hatch style, see enum above
     int                   m_hatchPitch;     // for DIAGONAL_EDGE, distance between 2 hatch lines
@@ -34,6 +34,8 @@
 #include <class_drawsegment.h>
 #include <math/util.h>      // for KiROUND
 
+#include <unordered_set>
+
 
 /* This module contains out of line member functions for classes given in
  * collectors.h.  Those classes augment the functionality of class PCB_EDIT_FRAME.
@@ -560,6 +562,70 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
 }
 
 
+void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
+                                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                                 const KIGFX::VIEW* aView )
+{
+    if( !aView )
+    {
+        Collect( aItem, aScanList, aRefPos, aGuide );
+        return;
+    }
+
+    Empty();        // empty the collection, primary criteria list
+    Empty2nd();     // empty the collection, secondary criteria list
+
+    SetGuide( &aGuide );
+    SetScanTypes( aScanList );
+    SetRefPos( aRefPos );
+
+    // Inspect() hit-tests with a slop of up to 10 pixels (zone corners), so look
+    // for candidates in a box at least that large
+    int   margin = KiROUND( 10 * aGuide.OnePixelInIU() ) + 1;
+    BOX2I area( VECTOR2I( aRefPos.x, aRefPos.y ), VECTOR2I( 0, 0 ) );
+    area.Inflate( margin );
+
+    std::vector<KIGFX::VIEW::LAYER_ITEM_PAIR> hits;
+    aView->Query( area, hits );
+
+    // An item is returned once for each of its layers: keep the first one.  The
+    // view also holds items which are not BOARD_ITEMs (worksheet, ratsnest...)
+    std::vector<BOARD_ITEM*>       candidates;
+    std::unordered_set<EDA_ITEM*>  seen;
+    BOARD*                         board = aItem->GetBoard();
+
+    for( const KIGFX::VIEW::LAYER_ITEM_PAIR& hit : hits )
+    {
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( hit.first );
+
+        if( !item || item->GetBoard() != board )
+            continue;
+
+        if( seen.insert( item ).second )
+            candidates.push_back( item );
+    }
+
+    // Inspect candidates in the order Visit() would have found them, i.e. by scan list
+    for( const KICAD_T* type = aScanList; *type != EOT; ++type )
+    {
+        for( BOARD_ITEM* item : candidates )
+        {
+            if( item->Type() == *type )
+                Inspect( item, nullptr );
+        }
+    }
+
+    // record the length of the primary list before concatenating on to it.
+    m_PrimaryLength = m_List.size();
+
+    // append 2nd list onto end of the first list
+    for( unsigned i = 0;  i<m_List2nd.size();  ++i )
+        Append( m_List2nd[i] );
+
+    Empty2nd();
+}
+
+
 SEARCH_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the
@@ -375,6 +375,22 @@ public:
      */
     void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
                  const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide );
+
+    /**
+     * Collect #BOARD_ITEMs near \a aRefPos using the R-tree of \a aView.
+     *
+     * Only the items whose view bounding box is close to \a aRefPos are inspected, so the
+     * cost does not depend on the board size.  Items on layers hidden in the view are not
+     * collected.  The result is ordered as with the other Collect() (by \a aScanList).
+     *
+     * @param aItem the BOARD or MODULE the items belong to.
+     * @param aScanList A list of KICAD_Ts with a terminating EOT.
+     * @param aRefPos A wxPoint to use in hit-testing.
+     * @param aGuide The COLLECTORS_GUIDE to use in collecting items.
+     * @param aView the view showing \a aItem.  If null, all items of \a aItem are visited.
+     */
+    void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[], const wxPoint& aRefPos,
+                  const COLLECTORS_GUIDE& aGuide, const KIGFX::VIEW* aView );
 };
 
 
@@ -41,6 +41,7 @@
 #include <tool/tool_manager.h>
 #include <tools/zone_filler_tool.h>
 #include <math/util.h>      // for KiROUND
+#include <widgets/progress_reporter.h>
 
 
 DIALOG_PLOT::DIALOG_PLOT( PCB_EDIT_FRAME* aParent ) :
@@ -823,6 +824,8 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    std::vector<PLOT_LAYER_JOB> jobs;
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         PCB_LAYER_ID layer = *seq;
@@ -848,31 +851,37 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
         wxString fullname = fn.GetFullName();
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        LOCALE_IO toggle;
+        PLOT_LAYER_JOB job;
+        job.m_Layer = layer;
+        job.m_FullFileName = fn.GetFullPath();
+        jobs.push_back( job );
+    }
 
-        PLOTTER*    plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(), wxEmptyString );
+    // The layers are independent and are plotted concurrently
+    {
+        WX_PROGRESS_REPORTER progressReporter( this, _( "Plotting" ), 1, false );
+        PlotBoardLayers( board, &m_plotOpts, jobs, &progressReporter );
+    }
 
-        // Print diags in messages box:
+    // Print diags in messages box, in plot order:
+    for( const PLOT_LAYER_JOB& job : jobs )
+    {
         wxString msg;
 
-        if( plotter )
+        if( job.m_Created )
         {
-            PlotOneBoardLayer( board, plotter, layer, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter;
-
-            msg.Printf( _( "Plot file \"%s\" created." ), fn.GetFullPath() );
+            msg.Printf( _( "Plot file \"%s\" created." ), job.m_FullFileName );
             reporter.Report( msg, RPT_SEVERITY_ACTION );
         }
         else
         {
-            msg.Printf( _( "Unable to create file \"%s\"." ), fn.GetFullPath() );
+            msg.Printf( _( "Unable to create file \"%s\"." ), job.m_FullFileName );
             reporter.Report( msg, RPT_SEVERITY_ERROR );
         }
-
-        wxSafeYield();      // displays report message.
     }
 
+    wxSafeYield();      // displays report message.
+
     if( m_plotOpts.GetFormat() == PLOT_FORMAT::GERBER && m_plotOpts.GetCreateGerberJobFile() )
     {
         // Pick the basename from the board file
@@ -27,7 +27,10 @@
 #include <cmath>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iomanip>
+#include <map>
+#include <memory>
 #include <vector>
 #include <wx/dir.h>
 
@@ -162,6 +165,12 @@ public:
     VRML_LAYER  m_bot_tin;
     VRML_LAYER  m_plated_holes;
 
+    // The copies of m_holes used to tesselate the other layers (see tesselate_layers())
+    std::vector< std::unique_ptr< VRML_LAYER > > m_layerHoles;
+
+    // The DEF name of each 3D model already written as an Inline, by model file name
+    std::map< wxString, wxString > m_inlineDefs;
+
     std::list< SGNODE* > m_components;
 
     bool m_plainPCB;
@@ -420,11 +429,54 @@ static void write_triangle_bag( std::ostream& aOut_file, VRML_COLOR& aColor,
 }
 
 
+/**
+ * Tesselate the board and all the layers to write.  The layers are independent and are
+ * tesselated concurrently; tesselating a layer renumbers the vertices of the holes used to
+ * tesselate it, so each layer gets its own copy of the holes.
+ */
+static void tesselate_layers( MODEL_VRML& aModel )
+{
+    std::vector< std::pair< VRML_LAYER*, VRML_LAYER* > > layers;
+
+    layers.emplace_back( &aModel.m_board, &aModel.m_holes );
+
+    if( !aModel.m_plainPCB )
+    {
+        for( VRML_LAYER* layer : { &aModel.m_top_copper, &aModel.m_top_tin, &aModel.m_bot_copper,
+                                   &aModel.m_bot_tin, &aModel.m_top_silk, &aModel.m_bot_silk } )
+        {
+            aModel.m_layerHoles.emplace_back( new VRML_LAYER );
+            aModel.m_layerHoles.back()->AppendLayer( aModel.m_holes );
+            layers.emplace_back( layer, aModel.m_layerHoles.back().get() );
+        }
+    }
+
+    std::vector< std::future< void > > returns;
+
+    for( const std::pair< VRML_LAYER*, VRML_LAYER* >& layer : layers )
+    {
+        returns.push_back( std::async( std::launch::async,
+                [layer]()
+                {
+                    layer.first->Tesselate( layer.second );
+                } ) );
+    }
+
+    // The plated holes are tesselated alone
+    if( !aModel.m_plainPCB )
+        aModel.m_plated_holes.Tesselate( NULL, true );
+
+    for( std::future< void >& ret : returns )
+        ret.wait();
+}
+
+
 static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     const char* aFileName, OSTREAM* aOutputFile )
 {
+    tesselate_layers( aModel );
+
     // VRML_LAYER board;
-    aModel.m_board.Tesselate( &aModel.m_holes );
     double brdz = aModel.m_brd_thickness / 2.0
                   - ( Millimeter2iu( ART_OFFSET / 2.0 ) ) * BOARD_SCALE;
 
@@ -447,7 +499,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_copper;
-    aModel.m_top_copper.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -462,7 +513,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_tin;
-    aModel.m_top_tin.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -479,7 +529,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_copper;
-    aModel.m_bot_copper.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -494,7 +543,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_tin;
-    aModel.m_bot_tin.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -512,7 +560,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER PTH;
-    aModel.m_plated_holes.Tesselate( NULL, true );
 
     if( USE_INLINES )
     {
@@ -529,7 +576,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_top_silk;
-    aModel.m_top_silk.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -543,7 +589,6 @@ static void write_layers( MODEL_VRML& aModel, BOARD* aPcb,
     }
 
     // VRML_LAYER m_bot_silk;
-    aModel.m_bot_silk.Tesselate( &aModel.m_holes );
 
     if( USE_INLINES )
     {
@@ -1358,6 +1403,62 @@ static void compose_quat( double q1[4], double q2[4], double qr[4] )
 }
 
 
+// the name of the copy of a 3D model file in the 3D subdirectory, when using inlines
+static wxFileName inline_model_filename( const wxString& aModelFile )
+{
+    wxFileName srcFile = cache->GetResolver()->ResolvePath( aModelFile );
+    wxFileName dstFile;
+    dstFile.SetPath( SUBDIR_3D );
+    dstFile.SetName( srcFile.GetName() );
+    dstFile.SetExt( "wrl"  );
+
+    return dstFile;
+}
+
+
+// copy a 3D model file to the 3D subdirectory, if necessary, when using inlines;
+// returns false if the model could not be copied
+static bool copy_inline_model( const wxString& aModelFile, SGNODE* aModel3D )
+{
+    wxFileName srcFile = cache->GetResolver()->ResolvePath( aModelFile );
+    wxFileName dstFile = inline_model_filename( aModelFile );
+
+    // copy the file if necessary
+    wxDateTime srcModTime = srcFile.GetModificationTime();
+    wxDateTime destModTime = srcModTime;
+
+    destModTime.SetToCurrent();
+
+    if( dstFile.FileExists() )
+        destModTime = dstFile.GetModificationTime();
+
+    if( srcModTime != destModTime )
+    {
+        wxLogDebug( "Copying 3D model %s to %s.",
+                    GetChars( srcFile.GetFullPath() ),
+                    GetChars( dstFile.GetFullPath() ) );
+
+        wxString fileExt = srcFile.GetExt();
+        fileExt.LowerCase();
+
+        // copy VRML models and use the scenegraph library to
+        // translate other model types
+        if( fileExt == "wrl" )
+        {
+            if( !wxCopyFile( srcFile.GetFullPath(), dstFile.GetFullPath() ) )
+                return false;
+        }
+        else
+        {
+            if( !S3D::WriteVRML( dstFile.GetFullPath().ToUTF8(), true, aModel3D, USE_DEFS, true ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
 static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
     MODULE* aModule, std::ostream* aOutputFile )
 {
@@ -1401,8 +1502,6 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
     auto sM = aModule->Models().begin();
     auto eM = aModule->Models().end();
 
-    wxFileName subdir( SUBDIR_3D, "" );
-
     while( sM != eM )
     {
         SGNODE* mod3d = (SGNODE*) cache->Load( sM->m_Filename );
@@ -1465,42 +1564,28 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
 
         if( USE_INLINES )
         {
-            wxFileName srcFile = cache->GetResolver()->ResolvePath( sM->m_Filename );
-            wxFileName dstFile;
-            dstFile.SetPath( SUBDIR_3D );
-            dstFile.SetName( srcFile.GetName() );
-            dstFile.SetExt( "wrl"  );
+            // Each model file is copied (if needed) and written as an Inline node only the
+            // first time it is used.  Other footprints using the same model refer to this
+            // node (DEF/USE), so the model is only loaded once by the VRML readers.
+            auto def = aModel.m_inlineDefs.find( sM->m_Filename );
+            bool writeInline = false;
 
-            // copy the file if necessary
-            wxDateTime srcModTime = srcFile.GetModificationTime();
-            wxDateTime destModTime = srcModTime;
+            if( def == aModel.m_inlineDefs.end() )
+            {
+                wxString defName;
 
-            destModTime.SetToCurrent();
+                if( copy_inline_model( sM->m_Filename, mod3d ) )
+                    defName.Printf( "MODEL_%u", (unsigned) aModel.m_inlineDefs.size() );
 
-            if( dstFile.FileExists() )
-                destModTime = dstFile.GetModificationTime();
+                // An empty name is stored for models which cannot be copied
+                def = aModel.m_inlineDefs.emplace( sM->m_Filename, defName ).first;
+                writeInline = !defName.IsEmpty();
+            }
 
-            if( srcModTime != destModTime )
+            if( def->second.IsEmpty() )
             {
-                wxLogDebug( "Copying 3D model %s to %s.",
-                            GetChars( srcFile.GetFullPath() ),
-                            GetChars( dstFile.GetFullPath() ) );
-
-                wxString fileExt = srcFile.GetExt();
-                fileExt.LowerCase();
-
-                // copy VRML models and use the scenegraph library to
-                // translate other model types
-                if( fileExt == "wrl" )
-                {
-                    if( !wxCopyFile( srcFile.GetFullPath(), dstFile.GetFullPath() ) )
-                        continue;
-                }
-                else
-                {
-                    if( !S3D::WriteVRML( dstFile.GetFullPath().ToUTF8(), true, mod3d, USE_DEFS, true ) )
-                        continue;
-                }
+                ++sM;
+                continue;
             }
 
             (*aOutputFile) << "Transform {\n";
@@ -1522,20 +1607,31 @@ static void export_vrml_module( MODEL_VRML& aModel, BOARD* aPcb,
             (*aOutputFile) << sM->m_Scale.y << " ";
             (*aOutputFile) << sM->m_Scale.z << "\n";
 
-            (*aOutputFile) << "  children [\n    Inline {\n      url \"";
+            if( writeInline )
+            {
+                (*aOutputFile) << "  children [\n    DEF " << TO_UTF8( def->second )
+                               << " Inline {\n      url \"";
+
+                wxFileName dstFile = inline_model_filename( sM->m_Filename );
+
+                if( USE_RELPATH )
+                {
+                    wxFileName tmp = dstFile;
+                    tmp.SetExt( "" );
+                    tmp.SetName( "" );
+                    tmp.RemoveLastDir();
+                    dstFile.MakeRelativeTo( tmp.GetPath() );
+                }
 
-            if( USE_RELPATH )
+                wxString fn = dstFile.GetFullPath();
+                fn.Replace( "\\", "/" );
+                (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
+            }
+            else
             {
-                wxFileName tmp = dstFile;
-                tmp.SetExt( "" );
-                tmp.SetName( "" );
-                tmp.RemoveLastDir();
-                dstFile.MakeRelativeTo( tmp.GetPath() );
+                (*aOutputFile) << "  children [\n    USE " << TO_UTF8( def->second ) << " ]\n";
             }
 
-            wxString fn = dstFile.GetFullPath();
-            fn.Replace( "\\", "/" );
-            (*aOutputFile) << TO_UTF8( fn ) << "\"\n    } ]\n";
             (*aOutputFile) << "  }\n";
         }
         else
@@ -90,18 +90,35 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     if( !m_merge_PTH_NPTH )
         hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    // The locale is switched once here: the drill files are written from several threads
+    LOCALE_IO toggle;
+
+    // Each layer pair has its own copy of this writer, to build its hole list and write its
+    // drill file concurrently with the other pairs.  The files are created (and reported)
+    // in layer pair order.
+    std::vector<EXCELLON_WRITER> writers( hole_sets.size(), *this );
+    std::vector<FILE*>           files( hole_sets.size(), nullptr );
+
+    // For separate drill files, the last layer pair is the NPTH drill file.
+    auto isNpthSet = [&]( size_t aSet )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
+        return m_merge_PTH_NPTH ? false : ( aSet == hole_sets.size() - 1 );
+    };
 
-        buildHolesList( pair, doing_npth );
+    runConcurrently( hole_sets.size(),
+            [&]( size_t aSet )
+            {
+                writers[aSet].buildHolesList( hole_sets[aSet], isNpthSet( aSet ) );
+            } );
+
+    for( size_t ii = 0; ii < hole_sets.size(); ++ii )
+    {
+        DRILL_LAYER_PAIR  pair = hole_sets[ii];
+        bool doing_npth = isNpthSet( ii );
 
         // The file is created if it has holes, or if it is the non plated drill file
         // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
+        if( writers[ii].getHolesCount() > 0 || doing_npth )
         {
             fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
             fn.SetPath( aPlotDirectory );
@@ -130,11 +147,21 @@ void EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                     }
                 }
 
-                createDrillFile( file, pair, doing_npth );
+                files[ii] = file;
             }
         }
     }
 
+    runConcurrently( hole_sets.size(),
+            [&]( size_t aSet )
+            {
+                if( files[aSet] )
+                {
+                    writers[aSet].createDrillFile( files[aSet], hole_sets[aSet],
+                                                   isNpthSet( aSet ) );
+                }
+            } );
+
     if( aGenMap )
         CreateMapFilesSet( aPlotDirectory, aReporter );
 }
@@ -22,6 +22,10 @@
  * or you may write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <fctsys.h>
 
 #include <class_board.h>
@@ -70,6 +74,28 @@ static bool CmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
 }
 
 
+void GENDRILL_WRITER_BASE::runConcurrently( size_t aCount,
+                                            const std::function<void( size_t )>& aJob )
+{
+    std::atomic<size_t> nextItem( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), aCount );
+    std::vector<std::future<void>> returns( parallelThreadCount );
+
+    auto job_lambda = [&]()
+    {
+        for( size_t i = nextItem++; i < aCount; i = nextItem++ )
+            aJob( i );
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, job_lambda );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].wait();
+}
+
+
 void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
                                            bool aGenerateNPTH_list )
 {
@@ -29,6 +29,7 @@
 #ifndef GENDRILL_FILE_WRITER_BASE_H
 #define GENDRILL_FILE_WRITER_BASE_H
 
+#include <functional>
 #include <vector>
 
 class BOARD_ITEM;
@@ -296,6 +297,15 @@ protected:
 
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
+    /**
+     * Function runConcurrently
+     * Run aJob( 0 ) ... aJob( aCount - 1 ), each one once, from several threads, and return
+     * when all of them are done.
+     * Used to build and write the drill files of several layer pairs at once, each job
+     * working on its own copy of the writer.
+     */
+    static void runConcurrently( size_t aCount, const std::function<void( size_t )>& aJob );
+
     /** Helper function.
      * Writes the drill marks in HPGL, POSTSCRIPT or other supported formats
      * Each hole size has a symbol (circle, cross X, cross + ...) up to
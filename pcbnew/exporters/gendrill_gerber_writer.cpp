@@ -76,47 +76,66 @@ void GERBER_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     // (Gerber drill files are separate files for PTH and NPTH)
     hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    // The locale is switched once here: the drill files are written from several threads
+    LOCALE_IO toggle;
+
+    // Each layer pair has its own copy of this writer, to build its hole list and write its
+    // drill file concurrently with the other pairs.  The files are reported in layer pair
+    // order.
+    std::vector<GERBER_WRITER> writers( hole_sets.size(), *this );
+    std::vector<wxString>      filenames( hole_sets.size() );
+    std::vector<int>           results( hole_sets.size(), 0 );
+
+    // For separate drill files, the last layer pair is the NPTH drill file.
+    auto isNpthSet = [&]( size_t aSet )
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = ( it == hole_sets.end() - 1 );
+        return aSet == hole_sets.size() - 1;
+    };
 
-        buildHolesList( pair, doing_npth );
+    runConcurrently( hole_sets.size(),
+            [&]( size_t aSet )
+            {
+                writers[aSet].buildHolesList( hole_sets[aSet], isNpthSet( aSet ) );
+            } );
 
+    for( size_t ii = 0; ii < hole_sets.size(); ++ii )
+    {
         // The file is created if it has holes, or if it is the non plated drill file
         // to be sure the NPTH file is up to date in separate files mode.
-        if( getHolesCount() > 0 || doing_npth )
+        if( aGenDrill && ( writers[ii].getHolesCount() > 0 || isNpthSet( ii ) ) )
         {
-            fn = getDrillFileName( pair, doing_npth, false );
+            fn = getDrillFileName( hole_sets[ii], isNpthSet( ii ), false );
             fn.SetPath( aPlotDirectory );
+            filenames[ii] = fn.GetFullPath();
+        }
+    }
 
-            if( aGenDrill )
+    runConcurrently( hole_sets.size(),
+            [&]( size_t aSet )
             {
-                wxString fullFilename = fn.GetFullPath();
-
-                int result = createDrillFile( fullFilename, doing_npth, pair );
-
-                if( result < 0 )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "** Unable to create %s **\n" ), fullFilename );
-                        aReporter->Report( msg );
-                    }
-                    break;
-                }
-                else
+                if( !filenames[aSet].IsEmpty() )
                 {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Create file %s\n" ), fullFilename );
-                        aReporter->Report( msg );
-                    }
+                    results[aSet] = writers[aSet].createDrillFile( filenames[aSet],
+                                                                   isNpthSet( aSet ),
+                                                                   hole_sets[aSet] );
                 }
+            } );
 
-            }
+    for( size_t ii = 0; ii < hole_sets.size() && aReporter; ++ii )
+    {
+        if( filenames[ii].IsEmpty() )
+            continue;
+
+        if( results[ii] < 0 )
+        {
+            msg.Printf( _( "** Unable to create %s **\n" ), filenames[ii] );
+            aReporter->Report( msg );
+            break;
+        }
+        else
+        {
+            msg.Printf( _( "Create file %s\n" ), filenames[ii] );
+            aReporter->Report( msg );
         }
     }
 
@@ -55,6 +55,11 @@
 
 #include <advanced_config.h> // for pad pin function and pad property feature management
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
 using namespace PCB_KEYS_T;
 
 
@@ -770,32 +775,120 @@ void PCB_IO::format( BOARD* aBoard, int aNestLevel ) const
 {
     formatHeader( aBoard, aNestLevel );
 
-    // Save the modules.
-    for( auto module : aBoard->Modules() )
+    // The board items are formatted in chunks of consecutive items.  On large boards the
+    // chunks are formatted by several threads, each into its own buffer, and the buffers are
+    // then output in order, so the file is the same as when formatting the items one after
+    // another.
+    struct CHUNK
     {
-        Format( module, aNestLevel );
-        m_out->Print( 0, "\n" );
-    }
+        std::vector<BOARD_ITEM*> m_items;
+        bool                     m_newLineAfterEach = false;
+        const char*              m_suffix = "";     // Output after the items
+        std::string              m_text;            // The formatted chunk
+    };
 
-    // Save the graphical items on the board (not owned by a module)
-    for( auto item : aBoard->Drawings() )
-        Format( item, aNestLevel );
+    std::vector<CHUNK> chunks;
+    size_t             itemCount = 0;
 
-    if( aBoard->Drawings().size() )
-        m_out->Print( 0, "\n" );
+    auto addChunks = [&]( const auto& aItems, size_t aChunkSize, bool aNewLineAfterEach,
+                          const char* aSuffix )
+    {
+        size_t first = chunks.size();
+
+        for( BOARD_ITEM* item : aItems )
+        {
+            if( chunks.size() == first || chunks.back().m_items.size() >= aChunkSize )
+            {
+                chunks.emplace_back();
+                chunks.back().m_newLineAfterEach = aNewLineAfterEach;
+            }
+
+            chunks.back().m_items.push_back( item );
+            itemCount++;
+        }
+
+        if( chunks.size() > first )
+            chunks.back().m_suffix = aSuffix;
+    };
+
+    // Save the modules, followed by an empty line.
+    addChunks( aBoard->Modules(), 16, true, "" );
+
+    // Save the graphical items on the board (not owned by a module)
+    addChunks( aBoard->Drawings(), 256, false, "\n" );
 
     // Do not save MARKER_PCBs, they can be regenerated easily.
 
     // Save the tracks and vias.
-    for( auto track : aBoard->Tracks() )
-        Format( track, aNestLevel );
-
-    if( aBoard->Tracks().size() )
-        m_out->Print( 0, "\n" );
+    addChunks( aBoard->Tracks(), 1024, false, "\n" );
 
     // Save the polygon (which are the newer technology) zones.
-    for( int i = 0; i < aBoard->GetAreaCount();  ++i )
-        Format( aBoard->GetArea( i ), aNestLevel );
+    addChunks( aBoard->Zones(), 1, false, "" );
+
+    auto formatChunk = [aNestLevel]( const PCB_IO& aIO, const CHUNK& aChunk )
+    {
+        for( BOARD_ITEM* item : aChunk.m_items )
+        {
+            aIO.Format( item, aNestLevel );
+
+            if( aChunk.m_newLineAfterEach )
+                aIO.m_out->Print( 0, "\n" );
+        }
+
+        aIO.m_out->Print( 0, "%s", aChunk.m_suffix );
+    };
+
+    // Not worth starting threads for small boards (or clipboard contents)
+    const size_t MIN_PARALLEL_ITEMS = 500;
+
+    size_t threadCount = 1;
+
+    if( itemCount >= MIN_PARALLEL_ITEMS )
+        threadCount = std::min<size_t>( std::thread::hardware_concurrency(), chunks.size() );
+
+    if( threadCount <= 1 )
+    {
+        for( const CHUNK& chunk : chunks )
+            formatChunk( *this, chunk );
+
+        return;
+    }
+
+    // Each thread has its own plugin, with its own output formatter.  They are built here,
+    // as building the parser of a plugin is not thread safe.
+    std::vector<std::unique_ptr<PCB_IO>> workers;
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
+    {
+        workers.push_back( std::make_unique<PCB_IO>( m_ctl ) );
+        workers.back()->m_board = m_board;
+        *workers.back()->m_mapping = *m_mapping;
+    }
+
+    std::atomic<size_t>            nextChunk( 0 );
+    std::vector<std::future<void>> returns( threadCount );
+
+    auto format_lambda = [&]( PCB_IO* aWorker )
+    {
+        for( size_t i = nextChunk++; i < chunks.size(); i = nextChunk++ )
+        {
+            STRING_FORMATTER formatter;
+
+            aWorker->SetOutputFormatter( &formatter );
+            formatChunk( *aWorker, chunks[i] );
+            chunks[i].m_text = formatter.GetString();
+        }
+    };
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, format_lambda, workers[ii].get() );
+
+    // get() rethrows the exceptions of the threads
+    for( size_t ii = 0; ii < threadCount; ++ii )
+        returns[ii].get();
+
+    for( const CHUNK& chunk : chunks )
+        m_out->PrintRaw( chunk.m_text );
 }
 
 
@@ -1949,6 +2042,14 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     const SHAPE_POLY_SET& fv = aZone->GetFilledPolysList();
     newLine = 0;
 
+    // The hash of the zone filler inputs the filled areas were built from, to know on load
+    // if they are up to date without filling the zone again
+    if( aZone->IsFilled() && aZone->GetFillInputsHash().IsValid() )
+    {
+        m_out->Print( aNestLevel+1, "(fill_inputs_hash %s)\n",
+                      aZone->GetFillInputsHash().ToHexString().c_str() );
+    }
+
     if( !fv.IsEmpty() )
     {
         bool new_polygon = true;
@@ -154,7 +154,7 @@ void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
         std::thread t = std::thread( [ &count_done, &next, &zones ]( )
         {
             for( size_t i = next.fetch_add( 1 ); i < zones.size(); i = next.fetch_add( 1 ) )
-                zones[i]->CacheTriangulation();
+                zones[i]->CacheTriangulation( false );
 
             count_done++;
         } );
@@ -378,6 +378,48 @@ void PCB_DRAW_PANEL_GAL::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANE
 }
 
 
+void PCB_DRAW_PANEL_GAL::onPaint( wxPaintEvent& aEvent )
+{
+    if( m_gal->IsVisible() )
+        updateLOD();
+
+    EDA_DRAW_PANEL_GAL::onPaint( aEvent );
+}
+
+
+void PCB_DRAW_PANEL_GAL::updateLOD()
+{
+    KIGFX::PAINTER* painter = m_view->GetPainter();
+    auto   settings = static_cast<KIGFX::PCB_RENDER_SETTINGS*>( painter->GetSettings() );
+    double oldScale = settings->GetLODScale();
+    double newScale = KIGFX::PCB_RENDER_SETTINGS::QuantizeLODScale( m_gal->GetWorldScale() );
+
+    if( oldScale == newScale )
+        return;
+
+    settings->SetLODScale( newScale );
+
+    // Redraw only the items that switch between the proxy and the full detail, and the zones,
+    // whose outlines are decimated to the pixel size of the current scale
+    m_view->UpdateAllItemsConditionally( KIGFX::REPAINT,
+            [oldScale, newScale]( KIGFX::VIEW_ITEM* aItem ) -> bool
+            {
+                EDA_ITEM* item = dynamic_cast<EDA_ITEM*>( aItem );
+
+                if( item && ( item->Type() == PCB_ZONE_AREA_T
+                                || item->Type() == PCB_MODULE_ZONE_AREA_T ) )
+                {
+                    return true;
+                }
+
+                const BOX2I bbox = aItem->ViewBBox();
+
+                return KIGFX::PCB_RENDER_SETTINGS::IsLODProxy( bbox, oldScale )
+                        != KIGFX::PCB_RENDER_SETTINGS::IsLODProxy( bbox, newScale );
+            } );
+}
+
+
 void PCB_DRAW_PANEL_GAL::OnShow()
 {
     PCB_BASE_FRAME* frame = dynamic_cast<PCB_BASE_FRAME*>( GetParent() );
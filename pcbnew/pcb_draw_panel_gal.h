@@ -108,6 +108,11 @@ public:
     virtual KIGFX::PCB_VIEW* GetView() const override;
 
 protected:
+    ///> @copydoc EDA_DRAW_PANEL_GAL::onPaint()
+    void onPaint( wxPaintEvent& aEvent ) override;
+
+    ///> Updates the level of detail to the current zoom and redraws the items it affects.
+    void updateLOD();
 
     ///> Reassigns layer order to the initial settings.
     void setDefaultLayerOrder();
@@ -45,6 +45,8 @@
 #include <geometry/geometry_utils.h>
 #include <geometry/shape_line_chain.h>
 
+#include <cmath>
+
 
 using namespace KIGFX;
 
@@ -297,12 +299,39 @@ const COLOR4D& PCB_RENDER_SETTINGS::GetColor( const VIEW_ITEM* aItem, int aLayer
 }
 
 
+double PCB_RENDER_SETTINGS::QuantizeLODScale( double aWorldScale )
+{
+    if( aWorldScale <= 0.0 )
+        return 0.0;
+
+    return std::exp2( std::floor( std::log2( aWorldScale ) ) );
+}
+
+
+bool PCB_RENDER_SETTINGS::IsLODProxy( const BOX2I& aBBox, double aScale )
+{
+    if( aScale <= 0.0 )
+        return false;
+
+    return std::max( aBBox.GetWidth(), aBBox.GetHeight() ) * aScale < LOD_THRESHOLD;
+}
+
+
 PCB_PAINTER::PCB_PAINTER( GAL* aGal ) :
     PAINTER( aGal )
 {
 }
 
 
+PAINTER* PCB_PAINTER::Clone( GAL* aGal ) const
+{
+    PCB_PAINTER* painter = new PCB_PAINTER( aGal );
+    painter->ApplySettings( &m_pcbSettings );
+
+    return painter;
+}
+
+
 int PCB_PAINTER::getLineThickness( int aActualThickness ) const
 {
     // if items have 0 thickness, draw them with the outline
@@ -340,6 +369,9 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
     if( !item )
         return false;
 
+    if( m_pcbSettings.GetLODScale() > 0.0 && drawLODProxy( item, aLayer ) )
+        return true;
+
     // the "cast" applied in here clarifies which overloaded draw() is called
     switch( item->Type() )
     {
@@ -405,6 +437,50 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+bool PCB_PAINTER::drawLODProxy( const EDA_ITEM* aItem, int aLayer )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_MODULE_T:      // footprints draw only their anchor
+    case PCB_MARKER_T:      // markers have to stay noticeable
+        return false;
+
+    default:
+        break;
+    }
+
+    const BOX2I bbox = aItem->ViewBBox();
+
+    if( !m_pcbSettings.IsLODProxy( bbox ) )
+        return false;
+
+    // Holes and net names are not visible at this size
+    if( IsNetnameLayer( aLayer ) || aLayer == LAYER_VIAS_HOLES
+            || aLayer == LAYER_PADS_PLATEDHOLES || aLayer == LAYER_NON_PLATEDHOLES )
+        return true;
+
+    const BOARD_ITEM* item = static_cast<const BOARD_ITEM*>( aItem );
+
+    // Zones, texts and graphics are drawn only on the layers they occupy (pads and vias
+    // report their own layers)
+    if( IsPcbLayer( aLayer ) && !item->IsOnLayer( (PCB_LAYER_ID) aLayer ) )
+        return true;
+
+    // Make sure the proxy covers at least one pixel
+    const double minSize = 1.0 / m_pcbSettings.GetLODScale();
+    VECTOR2D     center( bbox.Centre() );
+    VECTOR2D     halfSize( std::max<double>( bbox.GetWidth(), minSize ) / 2.0,
+                           std::max<double>( bbox.GetHeight(), minSize ) / 2.0 );
+
+    m_gal->SetIsFill( true );
+    m_gal->SetIsStroke( false );
+    m_gal->SetFillColor( m_pcbSettings.GetColor( item, aLayer ) );
+    m_gal->DrawRectangle( center - halfSize, center + halfSize );
+
+    return true;
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -1089,6 +1165,42 @@ void PCB_PAINTER::draw( const MODULE* aModule, int aLayer )
 }
 
 
+/**
+ * Removes the vertices closer than aMinDistance to the previously kept vertex.
+ */
+static SHAPE_LINE_CHAIN decimateChain( const SHAPE_LINE_CHAIN& aChain, double aMinDistance )
+{
+    SHAPE_LINE_CHAIN result;
+    int              count = aChain.PointCount();
+
+    if( count == 0 )
+        return result;
+
+    const double minDistSq = aMinDistance * aMinDistance;
+    VECTOR2I     last = aChain.CPoint( 0 );
+
+    result.Append( last );
+
+    for( int i = 1; i < count - 1; ++i )
+    {
+        const VECTOR2I& pt = aChain.CPoint( i );
+
+        if( (double) ( pt - last ).SquaredEuclideanNorm() >= minDistSq )
+        {
+            result.Append( pt );
+            last = pt;
+        }
+    }
+
+    if( count > 1 )
+        result.Append( aChain.CPoint( count - 1 ) );
+
+    result.SetClosed( aChain.IsClosed() );
+
+    return result;
+}
+
+
 void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
 {
     if( !aZone->IsOnLayer( (PCB_LAYER_ID) aLayer ) )
@@ -1116,14 +1228,25 @@ void PCB_PAINTER::draw( const ZONE_CONTAINER* aZone, int aLayer )
          * so each contour is draw as a simple polygon
          */
 
+        // At low zoom many vertices of the contours fall onto the same pixel
+        const double lodScale = m_pcbSettings.GetLODScale();
+
+        auto drawContour = [&]( const SHAPE_LINE_CHAIN& aContour )
+        {
+            if( lodScale > 0.0 )
+                m_gal->DrawPolyline( decimateChain( aContour, 1.0 / lodScale ) );
+            else
+                m_gal->DrawPolyline( aContour );
+        };
+
         // Draw the main contour
-        m_gal->DrawPolyline( outline->COutline( 0 ) );
+        drawContour( outline->COutline( 0 ) );
 
         // Draw holes
         int holes_count = outline->HoleCount( 0 );
 
         for( int ii = 0; ii < holes_count; ++ii )
-            m_gal->DrawPolyline( outline->CHole( 0, ii ) );
+            drawContour( outline->CHole( 0, ii ) );
 
         // Draw hatch lines
         for( const SEG& hatchLine : aZone->GetHatchLines() )
@@ -1245,3 +1368,4 @@ void PCB_PAINTER::draw( const MARKER_PCB* aMarker )
 
 
 const double PCB_RENDER_SETTINGS::MAX_FONT_SIZE = Millimeter2iu( 10.0 );
+const double PCB_RENDER_SETTINGS::LOD_THRESHOLD = 2.0;
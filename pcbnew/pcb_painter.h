@@ -28,6 +28,7 @@
 #define __CLASS_PCB_PAINTER_H
 
 #include <painter.h>
+#include <math/box2.h>
 
 #include <memory>
 
@@ -166,6 +167,27 @@ public:
     bool GetDrawIndividualViaLayers() const { return m_drawIndividualViaLayers; }
     void SetDrawIndividualViaLayers( bool aFlag ) { m_drawIndividualViaLayers = aFlag; }
 
+    /**
+     * Sets the scale (pixels per internal unit) used for level of detail decisions.  Items
+     * smaller than LOD_THRESHOLD pixels at this scale are drawn as simplified proxies.
+     * @param aScale is the scale, or 0 to always draw items with full detail (e.g. printing).
+     */
+    void SetLODScale( double aScale ) { m_lodScale = aScale; }
+    double GetLODScale() const { return m_lodScale; }
+
+    /**
+     * Rounds a GAL world scale down to a power of two, so the level of detail (and the
+     * cached geometry) changes only once per factor of two when zooming.
+     */
+    static double QuantizeLODScale( double aWorldScale );
+
+    /**
+     * Returns true if an item with a given bounding box is drawn as a proxy at a given scale.
+     */
+    static bool IsLODProxy( const BOX2I& aBBox, double aScale );
+
+    bool IsLODProxy( const BOX2I& aBBox ) const { return IsLODProxy( aBBox, m_lodScale ); }
+
 protected:
     ///> Flag determining if items on a given layer should be drawn as an outline or a filled item
     bool    m_sketchMode[GAL_LAYER_ID_END];
@@ -205,6 +227,12 @@ protected:
     ///> Maximum font size for netnames (and other dynamically shown strings)
     static const double MAX_FONT_SIZE;
 
+    ///> Size (in pixels) below which items are drawn as proxies
+    static const double LOD_THRESHOLD;
+
+    ///> Scale used for level of detail decisions (0 disables the proxies)
+    double  m_lodScale = 0.0;
+
     ///> Option for different display modes for zones
     DISPLAY_ZONE_MODE m_displayZone;
 
@@ -240,6 +268,15 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::CanClone()
+    virtual bool CanClone() const override
+    {
+        return true;
+    }
+
+    /// @copydoc PAINTER::Clone()
+    virtual PAINTER* Clone( GAL* aGal ) const override;
+
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
 
@@ -257,6 +294,14 @@ protected:
     void draw( const PCB_TARGET* aTarget );
     void draw( const MARKER_PCB* aMarker );
 
+    /**
+     * Function drawLODProxy()
+     * Draws a simplified version of an item that is too small on the screen to show
+     * any detail (a box or, for the smallest ones, a point).
+     * @return false if the item has to be drawn with full detail.
+     */
+    bool drawLODProxy( const EDA_ITEM* aItem, int aLayer );
+
     /**
      * Function getLineThickness()
      * Get the thickness to draw for a line (e.g. 0 thickness lines
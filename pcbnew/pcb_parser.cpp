@@ -3973,6 +3973,19 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
             }
             break;
 
+        case T_fill_inputs_hash:
+            {
+                MD5_HASH hash;
+
+                NeedSYMBOLorNUMBER();
+
+                // An invalid hash only means the fill is checked again, so it is not an error
+                hash.FromHexString( CurText() );
+                zone->SetFillInputsHash( hash );
+                NeedRIGHT();
+            }
+            break;
+
         case T_fill_segments:
             {
                 ZONE_SEGMENT_FILL segs;
@@ -3998,7 +4011,7 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
         default:
             Expecting( "net, layer/layers, tstamp, hatch, priority, connect_pads, min_thickness, "
-                       "fill, polygon, filled_polygon, or fill_segments" );
+                       "fill, polygon, fill_inputs_hash, filled_polygon, or fill_segments" );
         }
     }
 
@@ -29,6 +29,8 @@
 #ifndef PCBPLOT_H_
 #define PCBPLOT_H_
 
+#include <vector>
+
 #include <layers_id_colors_and_visibility.h>
 #include <math/util.h> // for KiROUND
 #include <pad_shapes.h>
@@ -50,6 +52,7 @@ class TEXTE_MODULE;
 class ZONE_CONTAINER;
 class BOARD;
 class REPORTER;
+class PROGRESS_REPORTER;
 
 
 // Define min and max reasonable values for plot/print scale
@@ -158,6 +161,32 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
                          const wxString& aFullFileName,
                          const wxString& aSheetDesc );
 
+/**
+ * One file of a multi-layer plot: the layer to plot and the file to plot it in.
+ */
+struct PLOT_LAYER_JOB
+{
+    PCB_LAYER_ID m_Layer;
+    wxString     m_FullFileName;
+    bool         m_Created = false;     ///< set by PlotBoardLayers() when the file is written
+};
+
+/**
+ * Function PlotBoardLayers
+ * plot several layers, each one in its own file.
+ * The plot files are opened in the calling thread, in job order, and the layers are then
+ * plotted concurrently, each one by its own plotter.  The content of each file is the same
+ * as when the layers are plotted one after another.
+ * @param aBoard = the board to plot
+ * @param aPlotOpts = the plot options, shared by all the jobs
+ * @param aJobs = the layers and file names to plot.  m_Created is updated for each job
+ * @param aProgressReporter = an optional progress reporter, advanced once per job
+ * @return the number of files created
+ */
+int PlotBoardLayers( BOARD* aBoard, PCB_PLOT_PARAMS* aPlotOpts,
+                     std::vector<PLOT_LAYER_JOB>& aJobs,
+                     PROGRESS_REPORTER* aProgressReporter = nullptr );
+
 /**
  * Function PlotOneBoardLayer
  * main function to plot one copper or technical layer.
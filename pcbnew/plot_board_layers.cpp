@@ -29,6 +29,11 @@
  */
 
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <fctsys.h>
 #include <common.h>
 #include <plotter.h>
@@ -54,6 +59,7 @@
 #include <pcbplot.h>
 #include <pcb_painter.h>
 #include <gbr_metadata.h>
+#include <widgets/progress_reporter.h>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -127,8 +133,9 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     aPlotter->StartBlock( NULL );
 
     // Plot all zones together so we don't end up with divots where zones touch each other.
-    ZONE_CONTAINER* zone = nullptr;
-    SHAPE_POLY_SET aggregateArea;
+    ZONE_CONTAINER*                    zone = nullptr;
+    SHAPE_POLY_SET                     aggregateArea;
+    std::vector<const SHAPE_POLY_SET*> filledAreas;
 
     for( ZONE_CONTAINER* candidate : aBoard->Zones() )
     {
@@ -138,11 +145,12 @@ void PlotSilkScreen( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         if( !zone )
             zone = candidate;
 
-        aggregateArea.BooleanAdd( candidate->GetFilledPolysList(), SHAPE_POLY_SET::PM_FAST );
+        filledAreas.push_back( &candidate->GetFilledPolysList() );
     }
 
     if( zone )
     {
+        aggregateArea.BooleanAdd( filledAreas, SHAPE_POLY_SET::PM_FAST );
         aggregateArea.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
         itemplotter.PlotFilledAreas( zone, aggregateArea );
     }
@@ -360,10 +368,9 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             extraSize.x += width_adj;
             extraSize.y += width_adj;
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
-            PAD_SHAPE_T padShape = pad->GetShape();
-            double padCornerRadius = pad->GetRoundRectCornerRadius();
+            // Inflated/deflated pads are plotted from a copy, so the board is never modified
+            // here and several layers can be plotted concurrently
+            D_PAD plotPad( *pad );
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -396,7 +403,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 else
                     delta.y = coord[1].x - coord[0].x;
 
-                pad->SetDelta( delta );
+                plotPad.SetDelta( delta );
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -413,37 +420,34 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aPlotOpt.ColorSettings()->GetColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-
             switch( pad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
-                pad->SetSize( padPlotsSize );
+                plotPad.SetSize( padPlotsSize );
 
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
+                    ( plotPad.GetSize() == pad->GetDrillSize() ) &&
                     ( pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
                     break;
 
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( &plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_RECT:
                 if( margin.x > 0 )
                 {
-                    pad->SetShape( PAD_SHAPE_ROUNDRECT );
-                    pad->SetSize( padPlotsSize );
-                    pad->SetRoundRectCornerRadius( margin.x );
+                    plotPad.SetShape( PAD_SHAPE_ROUNDRECT );
+                    plotPad.SetSize( padPlotsSize );
+                    plotPad.SetRoundRectCornerRadius( margin.x );
                 }
                 // Fall through
             case PAD_SHAPE_TRAPEZOID:
             case PAD_SHAPE_ROUNDRECT:
             case PAD_SHAPE_CHAMFERED_RECT:
-                pad->SetSize( padPlotsSize );
-                itemplotter.PlotPad( pad, color, plotMode );
+                plotPad.SetSize( padPlotsSize );
+                itemplotter.PlotPad( &plotPad, color, plotMode );
                 break;
 
             case PAD_SHAPE_CUSTOM:
@@ -472,12 +476,6 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             }
                 break;
             }
-
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( tmppadsize );
-            pad->SetDelta( deltaSize );
-            pad->SetShape( padShape );
-            pad->SetRoundRectCornerRadius( padCornerRadius );
         }
 
         aPlotter->EndBlock( NULL );
@@ -1269,3 +1267,114 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
     delete plotter;
     return NULL;
 }
+
+
+int PlotBoardLayers( BOARD* aBoard, PCB_PLOT_PARAMS* aPlotOpts,
+                     std::vector<PLOT_LAYER_JOB>& aJobs, PROGRESS_REPORTER* aProgressReporter )
+{
+    // The locale is switched once for all the jobs: the plot threads do not switch it
+    LOCALE_IO toggle;
+
+    if( aProgressReporter )
+        aProgressReporter->SetMaxProgress( aJobs.size() );
+
+    // Opening a plot file computes the board bounding box, so the plotters are created
+    // here, one after another
+    std::vector<PLOTTER*> plotters( aJobs.size(), nullptr );
+
+    for( size_t i = 0; i < aJobs.size(); ++i )
+    {
+        plotters[i] = StartPlotBoard( aBoard, aPlotOpts, aJobs[i].m_Layer,
+                                      aJobs[i].m_FullFileName, wxEmptyString );
+    }
+
+    // Pads cache their bounding radius: build it before the plot threads read it
+    for( MODULE* module : aBoard->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            pad->GetBoundingRadius();
+    }
+
+    auto plotJob = [&]( size_t aJob )
+    {
+        PLOTTER* plotter = plotters[aJob];
+
+        PlotOneBoardLayer( aBoard, plotter, aJobs[aJob].m_Layer, *aPlotOpts );
+        plotter->EndPlot();
+
+        delete plotter->RenderSettings();
+        delete plotter;
+
+        aJobs[aJob].m_Created = true;
+    };
+
+    // Solder mask layers temporarily change the board max error and the arc correction
+    // mode, so they cannot be plotted with other layers and are plotted first
+    std::vector<size_t> toPlot;
+
+    for( size_t i = 0; i < aJobs.size(); ++i )
+    {
+        if( !plotters[i] )
+        {
+            if( aProgressReporter )
+                aProgressReporter->AdvanceProgress();
+        }
+        else if( aJobs[i].m_Layer == F_Mask || aJobs[i].m_Layer == B_Mask )
+        {
+            plotJob( i );
+
+            if( aProgressReporter )
+            {
+                aProgressReporter->AdvanceProgress();
+                aProgressReporter->KeepRefreshing();
+            }
+        }
+        else
+        {
+            toPlot.push_back( i );
+        }
+    }
+
+    std::atomic<size_t> nextItem( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), toPlot.size() );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto plot_lambda = [&]( PROGRESS_REPORTER* aReporter ) -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextItem++; i < toPlot.size(); i = nextItem++ )
+        {
+            plotJob( toPlot[i] );
+            num++;
+
+            if( aReporter )
+                aReporter->AdvanceProgress();
+        }
+
+        return num;
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, plot_lambda, aProgressReporter );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        // Here we balance returns with a 100ms timeout to allow UI updating
+        std::future_status status;
+        do
+        {
+            if( aProgressReporter )
+                aProgressReporter->KeepRefreshing();
+
+            status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+        } while( status != std::future_status::ready );
+    }
+
+    return std::count_if( aJobs.begin(), aJobs.end(),
+                          []( const PLOT_LAYER_JOB& aJob )
+                          {
+                              return aJob.m_Created;
+                          } );
+}
@@ -734,6 +734,42 @@ void BRDITEMS_PLOTTER::PlotFilledAreas( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& p
      */
     int outline_thickness = aZone->GetFilledPolysUseThickness() ? aZone->GetMinThickness() : 0;
 
+    // Gerber files can store all the filled areas in a single region statement, followed
+    // by their outlines.  All are dark, so the drawing order does not matter.
+    if( GetPlotMode() == FILLED && m_plotter->GetPlotterType() == PLOT_FORMAT::GERBER )
+    {
+        std::vector< std::vector< wxPoint > > contours( polysList.OutlineCount() );
+
+        for( int idx = 0; idx < polysList.OutlineCount(); ++idx )
+        {
+            const SHAPE_LINE_CHAIN& outline = polysList.COutline( idx );
+            std::vector< wxPoint >& contour = contours[idx];
+
+            contour.reserve( outline.PointCount() + 1 );
+
+            for( int ic = 0; ic < outline.PointCount(); ++ic )
+                contour.emplace_back( wxPoint( outline.CPoint( ic ) ) );
+
+            // Close the outline
+            if( contour.size() && contour[0] != contour.back() )
+                contour.push_back( contour[0] );
+        }
+
+        GERBER_PLOTTER* gbrPlotter = static_cast<GERBER_PLOTTER*>( m_plotter );
+        gbrPlotter->PlotPolyRegions( contours, &gbr_metadata );
+
+        if( outline_thickness > 0 )
+        {
+            for( const std::vector< wxPoint >& contour : contours )
+            {
+                if( contour.size() > 1 )
+                    m_plotter->PlotPoly( contour, NO_FILL, outline_thickness, &gbr_metadata );
+            }
+        }
+
+        return;
+    }
+
     for( int idx = 0; idx < polysList.OutlineCount(); ++idx )
     {
         SHAPE_LINE_CHAIN& outline = polysList.Outline( idx );
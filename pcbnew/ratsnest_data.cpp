@@ -153,44 +153,117 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
 class RN_NET::TRIANGULATOR_STATE
 {
 private:
+    struct POS_HASH
+    {
+        std::size_t operator()( const VECTOR2I& aPos ) const
+        {
+            return std::hash<int>()( aPos.x ) ^ ( std::hash<int>()( aPos.y ) * 0x9e3779b9 );
+        }
+    };
+
+    using POS_MAP = std::unordered_map<VECTOR2I, int, POS_HASH>;
+
     std::vector<CN_ANCHOR_PTR>  m_allNodes;
 
-    std::list<hed::EDGE_PTR> hedTriangulation( std::vector<hed::NODE_PTR>& aNodes )
+    ///> Delaunay triangulation of the distinct anchor positions. It is kept between the
+    ///> updates, so only the positions that appeared or disappeared since the previous
+    ///> update have to be inserted or removed (e.g. the pads of a moved footprint).
+    hed::TRIANGULATION  m_triangulation;
+    bool                m_triangulationValid;
+
+    ///> Nodes of the triangulation, by position
+    std::unordered_map<VECTOR2I, hed::NODE_PTR, POS_HASH> m_triNodes;
+
+    void rebuildTriangulation( const POS_MAP& aPositions )
     {
-        hed::TRIANGULATION triangulator;
-        triangulator.CreateDelaunay( aNodes.begin(), aNodes.end() );
-        std::list<hed::EDGE_PTR> edges;
-        triangulator.GetEdges( edges );
+        std::vector<hed::NODE_PTR> triNodes;
 
-        return edges;
-    }
+        m_triangulation.CreateEmpty();
+        m_triNodes.clear();
+        triNodes.reserve( aPositions.size() );
+
+        for( const auto& pos : aPositions )
+            triNodes.push_back( std::make_shared<hed::NODE>( pos.first.x, pos.first.y ) );
+
+        // Inserting the nodes in order keeps the search for the enclosing triangle short
+        std::sort( triNodes.begin(), triNodes.end(),
+                [] ( const hed::NODE_PTR& aNode1, const hed::NODE_PTR& aNode2 )
+                {
+                    if( aNode1->GetY() != aNode2->GetY() )
+                        return aNode1->GetY() < aNode2->GetY();
 
+                    return aNode1->GetX() < aNode2->GetX();
+                } );
+
+        m_triangulationValid = true;
+
+        for( const hed::NODE_PTR& node : triNodes )
+        {
+            m_triangulationValid &= m_triangulation.InsertNode( node );
+            m_triNodes[ VECTOR2I( node->GetX(), node->GetY() ) ] = node;
+        }
+    }
 
-    // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
-    // have unique coordinates!
-    bool areNodesColinear( const std::vector<hed::NODE_PTR>& aNodes ) const
+    void updateTriangulation( const POS_MAP& aPositions )
     {
-        if ( aNodes.size() <= 2 )
-            return true;
+        std::vector<hed::NODE_PTR> removed;
+        std::vector<VECTOR2I>      added;
 
-        const auto p0 = aNodes[0]->Pos();
-        const auto v0 = aNodes[1]->Pos() - p0;
+        if( m_triangulationValid )
+        {
+            for( const auto& node : m_triNodes )
+            {
+                if( !aPositions.count( node.first ) )
+                    removed.push_back( node.second );
+            }
 
-        for( unsigned i = 2; i < aNodes.size(); i++ )
+            for( const auto& pos : aPositions )
+            {
+                if( !m_triNodes.count( pos.first ) )
+                    added.push_back( pos.first );
+            }
+        }
+
+        // Local updates are only worth it as long as most of the nodes stay in place
+        if( !m_triangulationValid
+                || ( removed.size() + added.size() ) * 2 > aPositions.size() )
         {
-            const auto v1 = aNodes[i]->Pos() - p0;
+            rebuildTriangulation( aPositions );
+            return;
+        }
 
-            if( v0.Cross( v1 ) != 0 )
+        for( const hed::NODE_PTR& node : removed )
+        {
+            if( !m_triangulation.RemoveNode( node ) )
             {
-                return false;
+                rebuildTriangulation( aPositions );
+                return;
             }
+
+            m_triNodes.erase( VECTOR2I( node->GetX(), node->GetY() ) );
         }
 
-        return true;
+        for( const VECTOR2I& pos : added )
+        {
+            auto node = std::make_shared<hed::NODE>( pos.x, pos.y );
+
+            if( !m_triangulation.InsertNode( node ) )
+            {
+                rebuildTriangulation( aPositions );
+                return;
+            }
+
+            m_triNodes[pos] = node;
+        }
     }
 
 public:
+    TRIANGULATOR_STATE() :
+        m_triangulationValid( false )
+    {
+    }
 
+    ///> Clears the list of anchors. The triangulation is kept for the next update.
     void Clear()
     {
         m_allNodes.clear();
@@ -205,87 +278,42 @@ public:
     {
         std::list<CN_EDGE> mstEdges;
         std::list<hed::EDGE_PTR> triangEdges;
-        std::vector<hed::NODE_PTR> triNodes;
 
         using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
         std::vector<ANCHOR_LIST> anchorChains;
+        POS_MAP positions;
 
-        triNodes.reserve( m_allNodes.size() );
-        anchorChains.resize( m_allNodes.size() );
-
-        std::sort( m_allNodes.begin(), m_allNodes.end(),
-                [] ( const CN_ANCHOR_PTR& aNode1, const CN_ANCHOR_PTR& aNode2 )
-        {
-            if( aNode1->Pos().y < aNode2->Pos().y )
-                return true;
-            else if( aNode1->Pos().y == aNode2->Pos().y )
-            {
-                return aNode1->Pos().x < aNode2->Pos().x;
-            }
-
-            return false;
-        }
-                );
-
-        CN_ANCHOR_PTR prev, last;
-        int id = 0;
-
+        // Anchors sharing a position are represented by a single triangulation node
         for( const auto& n : m_allNodes )
         {
-            if( !prev || prev->Pos() != n->Pos() )
-            {
-                auto tn = std::make_shared<hed::NODE> ( n->Pos().x, n->Pos().y );
+            auto it = positions.emplace( n->Pos(), (int) anchorChains.size() );
 
-                tn->SetId( id );
-                triNodes.push_back( tn );
-            }
+            if( it.second )
+                anchorChains.emplace_back();
 
-            id++;
-            prev = n;
+            anchorChains[ it.first->second ].push_back( n );
         }
 
-        int prevId = 0;
+        if( anchorChains.size() == 1 )
+            return mstEdges;
 
-        for( const auto& n : triNodes )
-        {
-            for( int i = prevId; i < n->Id(); i++ )
-                anchorChains[prevId].push_back( m_allNodes[ i ] );
+        updateTriangulation( positions );
 
-            prevId = n->Id();
-        }
+        for( const auto& pos : positions )
+            m_triNodes[ pos.first ]->SetId( pos.second );
 
-        for( int i = prevId; i < id; i++ )
-            anchorChains[prevId].push_back( m_allNodes[ i ] );
+        m_triangulation.GetEdges( triangEdges );
 
-        if( triNodes.size() == 1 )
+        for( const auto& e : triangEdges )
         {
-            return mstEdges;
-        }
-        else if( areNodesColinear( triNodes ) )
-        {
-            // special case: all nodes are on the same line - there's no
-            // triangulation for such set. In this case, we sort along any coordinate
-            // and chain the nodes together.
-            for(int i = 0; i < (int)triNodes.size() - 1; i++ )
-            {
-                auto src = m_allNodes[ triNodes[i]->Id() ];
-                auto dst = m_allNodes[ triNodes[i + 1]->Id() ];
-                mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
-            }
-        }
-        else
-        {
-            hed::TRIANGULATION triangulator;
-            triangulator.CreateDelaunay( triNodes.begin(), triNodes.end() );
-            triangulator.GetEdges( triangEdges );
+            // Skip the edges leading to the corners of the enclosing rectangle
+            if( e->GetSourceNode()->Id() < 0 || e->GetTargetNode()->Id() < 0 )
+                continue;
 
-            for( const auto& e : triangEdges )
-            {
-                auto    src = m_allNodes[ e->GetSourceNode()->Id() ];
-                auto    dst = m_allNodes[ e->GetTargetNode()->Id() ];
+            const auto& src = anchorChains[ e->GetSourceNode()->Id() ].front();
+            const auto& dst = anchorChains[ e->GetTargetNode()->Id() ].front();
 
-                mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
-            }
+            mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
         }
 
         for( unsigned int i = 0; i < anchorChains.size(); i++ )
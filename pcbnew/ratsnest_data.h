@@ -145,7 +145,8 @@ public:
     bool NearestBicoloredPair( const RN_NET& aOtherNet, CN_ANCHOR_PTR& aNode1, CN_ANCHOR_PTR& aNode2 ) const;
 
 protected:
-    ///> Recomputes ratsnest from scratch.
+    ///> Recomputes ratsnest. The triangulation of the nodes is kept between the updates and
+    ///> only the nodes that were added, moved or removed since the last one are processed.
     void compute();
 
     ///> Vector of nodes
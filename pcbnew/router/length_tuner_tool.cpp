@@ -245,6 +245,7 @@ void LENGTH_TUNER_TOOL::performTuning()
     }
 
     m_router->StopRouting();
+    saveRouterSession();
     controls()->SetAutoPan( false );
     controls()->ForceCursorPosition( false );
     highlightNet( false );
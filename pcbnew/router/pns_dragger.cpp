@@ -382,7 +382,8 @@ bool DRAGGER::dragWalkaround( const VECTOR2I& aP )
 
             if( wr.statusCcw == WALKAROUND::DONE && wr.statusCw == WALKAROUND::DONE )
             {
-                dragged = ( wr.lineCw.CLine().Length() < wr.lineCcw.CLine().Length() ? wr.lineCw : wr.lineCcw );
+                dragged = WALKAROUND::IsCcwPreferred( wr.lineCw, wr.lineCcw ) ? wr.lineCcw
+                                                                              : wr.lineCw;
                 ok = true;
             }
             else if ( wr.statusCw == WALKAROUND::DONE )
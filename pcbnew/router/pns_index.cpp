@@ -23,9 +23,95 @@
 
 namespace PNS {
 
+ITEM_TREE::ITEM_TREE() :
+    m_netTagsValid( false )
+{
+}
+
+
+ITEM_TREE::Rect ITEM_TREE::itemRect( const ITEM* aItem )
+{
+    BOX2I bbox = aItem->Shape()->BBox();
+    Rect  rect;
+
+    rect.m_min[0] = bbox.GetX();
+    rect.m_min[1] = bbox.GetY();
+    rect.m_min[2] = aItem->Layers().Start() * LAYER_PITCH;
+    rect.m_max[0] = bbox.GetRight();
+    rect.m_max[1] = bbox.GetBottom();
+    rect.m_max[2] = aItem->Layers().End() * LAYER_PITCH;
+
+    return rect;
+}
+
+
+void ITEM_TREE::Add( ITEM* aItem )
+{
+    Rect rect = itemRect( aItem );
+
+    Insert( rect.m_min, rect.m_max, aItem );
+    m_netTagsValid = false;
+}
+
+
+void ITEM_TREE::Remove( ITEM* aItem )
+{
+    Rect rect = itemRect( aItem );
+
+    RTree::Remove( rect.m_min, rect.m_max, aItem );
+    m_netTagsValid = false;
+}
+
+
+void ITEM_TREE::Clear()
+{
+    RemoveAll();
+    m_netTagsValid = false;
+}
+
+
+void ITEM_TREE::updateNetTags()
+{
+    if( m_netTagsValid )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_netTagsLock );
+
+    if( m_netTagsValid )
+        return;
+
+    m_netTags.clear();
+    tagNets( m_root );
+    m_netTagsValid = true;
+}
+
+
+int ITEM_TREE::tagNets( const Node* aNode )
+{
+    int net = -1;
+
+    for( int i = 0; i < aNode->m_count; i++ )
+    {
+        const Branch& branch = aNode->m_branch[i];
+        int branchNet = aNode->m_level > 0 ? tagNets( branch.m_child ) : branch.m_data->Net();
+
+        if( branchNet < 0 || ( i > 0 && branchNet != net ) )
+            net = -2;
+        else if( net != -2 )
+            net = branchNet;
+    }
+
+    // Keep the map small: untagged (mixed) subtrees are the default
+    if( net < 0 )
+        return -1;
+
+    m_netTags[aNode] = net;
+    return net;
+}
+
+
 INDEX::INDEX()
 {
-    memset( m_subIndices, 0, sizeof( m_subIndices ) );
 }
 
 
@@ -35,62 +121,30 @@ INDEX::~INDEX()
 }
 
 
-INDEX::ITEM_SHAPE_INDEX* INDEX::getSubindex( const ITEM* aItem )
+bool INDEX::isIndexed( const ITEM* aItem )
 {
-    int idx_n = -1;
-
-    const LAYER_RANGE& l = aItem->Layers();
-
     switch( aItem->Kind() )
     {
     case ITEM::VIA_T:
-        idx_n = SI_Multilayer;
-        break;
-
     case ITEM::SOLID_T:
-        {
-            if( l.IsMultilayer() )
-                idx_n = SI_Multilayer;
-            else if( l.Start() == B_Cu ) // fixme: use kicad layer codes
-                idx_n = SI_PadsTop;
-            else if( l.Start() == F_Cu )
-                idx_n = SI_PadsBottom;
-            else
-                idx_n = SI_Traces + 2 * l.Start() + SI_SegStraight;
-        }
-        break;
-
     case ITEM::ARC_T:
     case ITEM::SEGMENT_T:
     case ITEM::LINE_T:
-        idx_n = SI_Traces + 2 * l.Start() + SI_SegStraight;
-        break;
+        return true;
 
     default:
-        break;
-    }
-
-    if( idx_n < 0 || idx_n >= MaxSubIndices )
-    {
-        wxASSERT( idx_n >= 0 );
-        wxASSERT( idx_n < MaxSubIndices );
-        return nullptr;
+        wxASSERT_MSG( false, "Unsupported item kind in the router index" );
+        return false;
     }
-
-    if( !m_subIndices[idx_n] )
-        m_subIndices[idx_n] = new ITEM_SHAPE_INDEX;
-
-    return m_subIndices[idx_n];
 }
 
+
 void INDEX::Add( ITEM* aItem )
 {
-    ITEM_SHAPE_INDEX* idx = getSubindex( aItem );
-
-    if( !idx )
+    if( !isIndexed( aItem ) )
         return;
 
-    idx->Add( aItem );
+    m_tree.Add( aItem );
     m_allItems.insert( aItem );
     int net = aItem->Net();
 
@@ -100,14 +154,13 @@ void INDEX::Add( ITEM* aItem )
     }
 }
 
+
 void INDEX::Remove( ITEM* aItem )
 {
-    ITEM_SHAPE_INDEX* idx = getSubindex( aItem );
-
-    if( !idx )
+    if( !isIndexed( aItem ) )
         return;
 
-    idx->Remove( aItem );
+    m_tree.Remove( aItem );
     m_allItems.erase( aItem );
     int net = aItem->Net();
 
@@ -115,6 +168,7 @@ void INDEX::Remove( ITEM* aItem )
         m_netMap[net].remove( aItem );
 }
 
+
 void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 {
     Remove( aOldItem );
@@ -124,15 +178,9 @@ void INDEX::Replace( ITEM* aOldItem, ITEM* aNewItem )
 
 void INDEX::Clear()
 {
-    for( int i = 0; i < MaxSubIndices; ++i )
-    {
-        ITEM_SHAPE_INDEX* idx = m_subIndices[i];
-
-        if( idx )
-            delete idx;
-
-        m_subIndices[i] = NULL;
-    }
+    m_tree.Clear();
+    m_netMap.clear();
+    m_allItems.clear();
 }
 
 
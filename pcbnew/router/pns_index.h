@@ -23,31 +23,91 @@
 #define __PNS_INDEX_H
 
 #include <layers_id_colors_and_visibility.h>
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <boost/range/adaptor/map.hpp>
 
 #include <list>
-#include <geometry/shape_index.h>
+#include <geometry/rtree.h>
+#include <geometry/shape.h>
 
 #include "pns_item.h"
 
 namespace PNS {
 
 
+/**
+ * ITEM_TREE
+ *
+ * R-Tree of router items spanning the board plane and the layer axis, so items on any
+ * range of layers are kept in a single tree and a query only visits the layers it asks for.
+ * Each subtree is tagged with the net all of its items belong to (if any), which lets
+ * queries that ignore one net skip whole subtrees of that net instead of rejecting the
+ * items one by one.
+ **/
+class ITEM_TREE : public RTree<ITEM*, int, 3, double>
+{
+public:
+    ITEM_TREE();
+
+    void Add( ITEM* aItem );
+    void Remove( ITEM* aItem );
+    void Clear();
+
+    /**
+     * Function Query()
+     *
+     * Calls aVisitor for each item whose bounding box overlaps aBox and whose layers
+     * overlap aLayers. Items of net aExcludeNet (if non-negative) are skipped.
+     * @return number of items visited.
+     */
+    template <class Visitor>
+    int Query( const BOX2I& aBox, const LAYER_RANGE& aLayers, int aExcludeNet,
+               Visitor& aVisitor );
+
+private:
+    ///> Distance between layers along the layer axis. Big enough for the tree to group
+    ///> items by layer first, small enough to keep all the copper layers in range.
+    static const int LAYER_PITCH = 10000000;
+
+    static Rect itemRect( const ITEM* aItem );
+
+    template <class Visitor>
+    bool search( Node* aNode, Rect& aRect, int aExcludeNet, Visitor& aVisitor, int& aCount );
+
+    ///> Returns the net of all the items in the subtree, -1 if mixed or unconnected.
+    int netTag( const Node* aNode ) const
+    {
+        auto tag = m_netTags.find( aNode );
+        return tag == m_netTags.end() ? -1 : tag->second;
+    }
+
+    void updateNetTags();
+    int tagNets( const Node* aNode );
+
+    ///> The tree is modified by the owning NODE only, but can be queried from several
+    ///> threads, so the net tags are rebuilt (once) by the first query that needs them.
+    std::unordered_map<const Node*, int> m_netTags;
+    std::atomic<bool>                    m_netTagsValid;
+    std::mutex                           m_netTagsLock;
+};
+
+
 /**
  * INDEX
  *
- * Custom spatial index, holding our board items and allowing for very fast searches. Items
- * are assigned to separate R-Tree subindices depending on their type and spanned layers, reducing
- * overlap and improving search time.
+ * Custom spatial index, holding our board items and allowing for very fast searches. All
+ * items are kept in a single layered R-Tree (see ITEM_TREE), so searches on a range of layers
+ * and searches ignoring the items of a net are done in a single tree traversal.
  **/
 class INDEX
 {
 public:
     typedef std::list<ITEM*>            NET_ITEMS_LIST;
-    typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
     INDEX();
@@ -85,10 +145,11 @@ public:
      * @param aMinDistance proximity distance (wrs to the item's shape)
      * @param aVisitor function object called on each found item. Return
               false from the visitor to stop searching.
+     * @param aExcludeNet if non-negative, items of this net are not reported.
      * @return number of items found.
      */
     template<class Visitor>
-    int Query( const ITEM* aItem, int aMinDistance, Visitor& aVisitor );
+    int Query( const ITEM* aItem, int aMinDistance, Visitor& aVisitor, int aExcludeNet = -1 );
 
     /**
      * Function Query()
@@ -141,76 +202,94 @@ public:
     ITEM_SET::iterator end() { return m_allItems.end(); }
 
 private:
-    static const int    MaxSubIndices   = 128;
-    static const int    SI_Multilayer   = 2;
-    static const int    SI_SegDiagonal  = 0;
-    static const int    SI_SegStraight  = 1;
-    static const int    SI_Traces       = 3;
-    static const int    SI_PadsTop      = 0;
-    static const int    SI_PadsBottom   = 1;
-
-    template <class Visitor>
-    int querySingle( int index, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor );
+    static bool isIndexed( const ITEM* aItem );
 
-    ITEM_SHAPE_INDEX* getSubindex( const ITEM* aItem );
-
-    ITEM_SHAPE_INDEX* m_subIndices[MaxSubIndices];
+    ITEM_TREE m_tree;
     std::map<int, NET_ITEMS_LIST> m_netMap;
     ITEM_SET m_allItems;
 };
 
 
-template<class Visitor>
-int INDEX::querySingle( int index, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor )
+template <class Visitor>
+int ITEM_TREE::Query( const BOX2I& aBox, const LAYER_RANGE& aLayers, int aExcludeNet,
+                      Visitor& aVisitor )
 {
-    if( !m_subIndices[index] )
-        return 0;
+    Rect rect;
+
+    rect.m_min[0] = aBox.GetX();
+    rect.m_min[1] = aBox.GetY();
+    rect.m_min[2] = aLayers.Start() * LAYER_PITCH;
+    rect.m_max[0] = aBox.GetRight();
+    rect.m_max[1] = aBox.GetBottom();
+    rect.m_max[2] = aLayers.End() * LAYER_PITCH;
 
-    return m_subIndices[index]->Query( aShape, aMinDistance, aVisitor, false );
+    if( aExcludeNet >= 0 )
+    {
+        updateNetTags();
+
+        if( netTag( m_root ) == aExcludeNet )
+            return 0;
+    }
+
+    int count = 0;
+    search( m_root, rect, aExcludeNet, aVisitor, count );
+
+    return count;
 }
 
-template<class Visitor>
-int INDEX::Query( const ITEM* aItem, int aMinDistance, Visitor& aVisitor )
+
+template <class Visitor>
+bool ITEM_TREE::search( Node* aNode, Rect& aRect, int aExcludeNet, Visitor& aVisitor,
+                        int& aCount )
 {
-    const SHAPE* shape = aItem->Shape();
-    int total = 0;
+    for( int i = 0; i < aNode->m_count; i++ )
+    {
+        Branch& branch = aNode->m_branch[i];
 
-    total += querySingle( SI_Multilayer, shape, aMinDistance, aVisitor );
+        if( !Overlap( &aRect, &branch.m_rect ) )
+            continue;
 
-    const LAYER_RANGE& layers = aItem->Layers();
+        if( aNode->IsInternalNode() )
+        {
+            if( aExcludeNet >= 0 && netTag( branch.m_child ) == aExcludeNet )
+                continue;
 
-    if( layers.IsMultilayer() )
-    {
-        total += querySingle( SI_PadsTop, shape, aMinDistance, aVisitor );
-        total += querySingle( SI_PadsBottom, shape, aMinDistance, aVisitor );
+            if( !search( branch.m_child, aRect, aExcludeNet, aVisitor, aCount ) )
+                return false;
+        }
+        else
+        {
+            if( aExcludeNet >= 0 && branch.m_data->Net() == aExcludeNet )
+                continue;
 
-        for( int i = layers.Start(); i <= layers.End(); ++i )
-            total += querySingle( SI_Traces + 2 * i + SI_SegStraight, shape, aMinDistance, aVisitor );
+            if( !aVisitor( branch.m_data ) )
+                return false;
+
+            aCount++;
+        }
     }
-    else
-    {
-        int l = layers.Start();
 
-        if( l == B_Cu )
-            total += querySingle( SI_PadsTop, shape, aMinDistance, aVisitor );
-        else if( l == F_Cu )
-            total += querySingle( SI_PadsBottom, shape, aMinDistance, aVisitor );
+    return true;
+}
+
 
-        total += querySingle(  SI_Traces + 2 * l + SI_SegStraight, shape, aMinDistance, aVisitor );
-    }
+template<class Visitor>
+int INDEX::Query( const ITEM* aItem, int aMinDistance, Visitor& aVisitor, int aExcludeNet )
+{
+    BOX2I box = aItem->Shape()->BBox();
+    box.Inflate( aMinDistance );
 
-    return total;
+    return m_tree.Query( box, aItem->Layers(), aExcludeNet, aVisitor );
 }
 
+
 template<class Visitor>
 int INDEX::Query( const SHAPE* aShape, int aMinDistance, Visitor& aVisitor )
 {
-    int total = 0;
-
-    for( int i = 0; i < MaxSubIndices; i++ )
-        total += querySingle( i, aShape, aMinDistance, aVisitor );
+    BOX2I box = aShape->BBox();
+    box.Inflate( aMinDistance );
 
-    return total;
+    return m_tree.Query( box, LAYER_RANGE( 0, PCB_LAYER_ID_COUNT ), -1, aVisitor );
 }
 
 };
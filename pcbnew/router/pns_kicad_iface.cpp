@@ -906,7 +906,7 @@ bool PNS_KICAD_IFACE_BASE::syncZone( PNS::NODE* aWorld, ZONE_CONTAINER* aZone )
         if ( ! layers[layer] )
             continue;
 
-        for( int outline = 0; outline < poly.OutlineCount(); outline++ )
+        for( unsigned int outline = 0; outline < poly.TriangulatedPolyCount(); outline++ )
         {
             auto tri = poly.TriangulatedPolygon( outline );
 
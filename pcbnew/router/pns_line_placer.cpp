@@ -433,7 +433,9 @@ bool LINE_PLACER::rhWalkOnly( const VECTOR2I& aP, LINE& aNewHead )
 
     }
 
-    walkFull.SetShape( l_ccw.Length() < l_cw.Length() ? l_ccw : l_cw );
+    LINE cand_cw( m_head, l_cw ), cand_ccw( m_head, l_ccw );
+
+    walkFull.SetShape( WALKAROUND::IsCcwPreferred( cand_cw, cand_ccw ) ? l_ccw : l_cw );
 
     Dbg()->AddLine( walkFull.CLine(), 2, 100000, "walk-full" );
 
@@ -25,12 +25,21 @@
 #include "pns_line.h"
 #include "pns_segment.h"
 #include "pns_solid.h"
+#include "pns_arc.h"
+#include "pns_node.h"
+#include "pns_routing_settings.h"
+#include "pns_sizes_settings.h"
+
+#include <algorithm>
+
+#include <class_board_connected_item.h>
 
 #include <geometry/shape.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_rect.h>
 #include <geometry/shape_circle.h>
 #include <geometry/shape_simple.h>
+#include <geometry/shape_arc.h>
 
 namespace PNS {
 
@@ -107,6 +116,17 @@ void LOGGER::Log ( const ITEM* aItem, int aKind, const std::string& aName )
         break;
     }
 
+    case ITEM::ARC_T:
+    {
+        ARC* a = (ARC*) aItem;
+        const SHAPE_ARC& arc = *static_cast<const SHAPE_ARC*>( a->Shape() );
+        m_theLog << " arc ";
+        m_theLog << a->Width() << " 0 " << arc.GetP0().x << " " << arc.GetP0().y << " " <<
+                    arc.GetArcMid().x << " " << arc.GetArcMid().y << " " <<
+                    arc.GetP1().x << " " << arc.GetP1().y << std::endl;
+        break;
+    }
+
     case ITEM::SOLID_T:
     {
         SOLID* s = (SOLID*) aItem;
@@ -194,6 +214,195 @@ void LOGGER::dumpShape( const SHAPE* aSh )
 }
 
 
+std::vector<std::string> LOGGER::FormatNode( const NODE* aNode )
+{
+    NODE::ITEM_VECTOR items;
+    aNode->AllItems( items );
+
+    LOGGER formatter;
+
+    for( const ITEM* item : items )
+        formatter.Log( item );
+
+    std::vector<std::string> lines;
+    std::istringstream       log( formatter.GetLog() );
+    std::string              line;
+
+    while( std::getline( log, line ) )
+        lines.push_back( line );
+
+    // The index is unordered, sort the items so the same world always gives the same log
+    std::sort( lines.begin(), lines.end() );
+
+    return lines;
+}
+
+
+uint64_t LOGGER::HashNode( const std::vector<std::string>& aItemLines )
+{
+    // FNV-1a, so the hashes stay the same across platforms and builds
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for( const std::string& line : aItemLines )
+    {
+        for( char c : line )
+        {
+            hash ^= (unsigned char) c;
+            hash *= 0x100000001b3ULL;
+        }
+
+        hash ^= '\n';
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+
+void LOGGER::LogNode( const NODE* aNode, const std::string& aName )
+{
+    NewGroup( aName );
+
+    for( const std::string& line : FormatNode( aNode ) )
+        m_theLog << line << std::endl;
+
+    EndGroup();
+}
+
+
+void LOGGER::LogSync( const NODE* aNode )
+{
+    std::vector<std::string> lines = FormatNode( aNode );
+
+    m_theLog << "sync " << lines.size() << " " << HashNode( lines ) << std::endl;
+}
+
+
+void LOGGER::LogSettings( int aRouterMode, ROUTING_SETTINGS& aSettings,
+                          const SIZES_SETTINGS& aSizes )
+{
+    m_theLog << "settings " << aRouterMode << " " << (int) aSettings.Mode() << " " <<
+                (int) aSettings.OptimizerEffort() << " " << aSettings.ShoveVias() << " " <<
+                aSettings.RemoveLoops() << " " << aSettings.SmartPads() << " " <<
+                aSettings.SuggestFinish() << " " << aSettings.SmoothDraggedSegments() << " " <<
+                aSettings.JumpOverObstacles() << " " << aSettings.CanViolateDRC() << " " <<
+                aSettings.GetFreeAngleMode() << " " << aSettings.InlineDragEnabled() << " " <<
+                aSettings.GetSnapToTracks() << " " << aSettings.GetSnapToPads() << " " <<
+                aSettings.GetRounded() << " " << aSettings.GetOptimizeDraggedTrack() << " " <<
+                aSettings.GetMinRadius() << " " << aSettings.GetMaxRadius() << " ";
+
+    m_theLog << aSizes.TrackWidth() << " " << aSizes.ViaDiameter() << " " <<
+                aSizes.ViaDrill() << " " << (int) aSizes.ViaType() << " " <<
+                aSizes.DiffPairWidth() << " " << aSizes.DiffPairGap() << " " <<
+                aSizes.DiffPairViaGap() << " " << aSizes.DiffPairViaGapSameAsTraceGap() << " " <<
+                aSizes.GetLayerTop() << " " << aSizes.GetLayerBottom() << std::endl;
+}
+
+
+void LOGGER::LogEvent( EVENT_TYPE aType, const VECTOR2I& aPos, const std::vector<ITEM*>& aItems,
+                       int aArg )
+{
+    int count = std::count_if( aItems.begin(), aItems.end(),
+                               []( const ITEM* aItem ) { return aItem != nullptr; } );
+
+    m_theLog << "event " << (int) aType << " " << aPos.x << " " << aPos.y << " " << aArg << " " <<
+                count;
+
+    for( const ITEM* item : aItems )
+    {
+        std::string uuid = "-";
+
+        if( !item )
+            continue;
+
+        if( item->Parent() )
+            uuid = item->Parent()->m_Uuid.AsString().ToStdString();
+
+        m_theLog << " " << uuid << " " << (int) item->Kind() << " " << item->Net() << " " <<
+                    item->Layers().Start();
+    }
+
+    m_theLog << std::endl;
+}
+
+
+bool LOGGER::ParseSettings( const std::string& aLine, int& aRouterMode,
+                            ROUTING_SETTINGS& aSettings, SIZES_SETTINGS& aSizes )
+{
+    std::istringstream s( aLine );
+    std::string        keyword;
+    int mode, effort, minRadius, maxRadius;
+    bool shoveVias, removeLoops, smartPads, suggestFinish, smoothDragged, jumpOver;
+    bool canViolate, freeAngle, inlineDrag, snapTracks, snapPads, rounded, optimizeDragged;
+    int trackWidth, viaDiameter, viaDrill, viaType, dpWidth, dpGap, dpViaGap;
+    bool dpViaGapSameAsTraceGap;
+    int layerTop, layerBottom;
+
+    s >> keyword >> aRouterMode >> mode >> effort >> shoveVias >> removeLoops >> smartPads >>
+         suggestFinish >> smoothDragged >> jumpOver >> canViolate >> freeAngle >> inlineDrag >>
+         snapTracks >> snapPads >> rounded >> optimizeDragged >> minRadius >> maxRadius;
+
+    s >> trackWidth >> viaDiameter >> viaDrill >> viaType >> dpWidth >> dpGap >> dpViaGap >>
+         dpViaGapSameAsTraceGap >> layerTop >> layerBottom;
+
+    if( !s || keyword != "settings" )
+        return false;
+
+    aSettings.SetMode( (PNS_MODE) mode );
+    aSettings.SetOptimizerEffort( (PNS_OPTIMIZATION_EFFORT) effort );
+    aSettings.SetShoveVias( shoveVias );
+    aSettings.SetRemoveLoops( removeLoops );
+    aSettings.SetSmartPads( smartPads );
+    aSettings.SetSuggestFinish( suggestFinish );
+    aSettings.SetSmoothDraggedSegments( smoothDragged );
+    aSettings.SetJumpOverObstacles( jumpOver );
+    aSettings.SetCanViolateDRC( canViolate );
+    aSettings.SetFreeAngleMode( freeAngle );
+    aSettings.SetInlineDragEnabled( inlineDrag );
+    aSettings.SetSnapToTracks( snapTracks );
+    aSettings.SetSnapToPads( snapPads );
+    aSettings.SetRounded( rounded );
+    aSettings.SetOptimizeDraggedTrack( optimizeDragged );
+    aSettings.SetMinRadius( minRadius );
+    aSettings.SetMaxRadius( maxRadius );
+
+    aSizes.SetTrackWidth( trackWidth );
+    aSizes.SetViaDiameter( viaDiameter );
+    aSizes.SetViaDrill( viaDrill );
+    aSizes.SetViaType( (VIATYPE) viaType );
+    aSizes.SetDiffPairWidth( dpWidth );
+    aSizes.SetDiffPairGap( dpGap );
+    aSizes.SetDiffPairViaGap( dpViaGap );
+    aSizes.SetDiffPairViaGapSameAsTraceGap( dpViaGapSameAsTraceGap );
+    aSizes.ClearLayerPairs();
+    aSizes.AddLayerPair( layerTop, layerBottom );
+
+    return true;
+}
+
+
+bool LOGGER::ParseEvent( const std::string& aLine, EVENT_ENTRY& aEvent )
+{
+    std::istringstream s( aLine );
+    std::string        keyword;
+    int                type;
+    size_t             count;
+
+    s >> keyword >> type >> aEvent.m_pos.x >> aEvent.m_pos.y >> aEvent.m_arg >> count;
+
+    if( !s || keyword != "event" )
+        return false;
+
+    aEvent.m_type = (EVENT_TYPE) type;
+    aEvent.m_items.resize( count );
+
+    for( ITEM_REF& ref : aEvent.m_items )
+        s >> ref.m_uuid >> ref.m_kind >> ref.m_net >> ref.m_layer;
+
+    return !s.fail();
+}
+
+
 void LOGGER::Save( const std::string& aFilename )
 {
     EndGroup();
@@ -22,6 +22,7 @@
 #ifndef __PNS_LOGGER_H
 #define __PNS_LOGGER_H
 
+#include <cstdint>
 #include <cstdio>
 #include <vector>
 #include <string>
@@ -35,10 +36,47 @@ class SHAPE;
 namespace PNS {
 
 class ITEM;
+class NODE;
+class ROUTING_SETTINGS;
+class SIZES_SETTINGS;
 
 class LOGGER
 {
 public:
+    ///> Kinds of router events recorded in a session log
+    enum EVENT_TYPE
+    {
+        EVT_START_ROUTE = 0,
+        EVT_START_DRAG,
+        EVT_FIX,
+        EVT_MOVE,
+        EVT_UNFIX,
+        EVT_COMMIT,
+        EVT_ABORT,
+        EVT_SWITCH_LAYER,
+        EVT_TOGGLE_VIA,
+        EVT_FLIP_POSTURE
+    };
+
+    ///> Reference to the item passed to the router along with an event. The parent board
+    ///> item is identified by its UUID, the kind, net and layer allow finding items created
+    ///> by the router itself (these have no parent).
+    struct ITEM_REF
+    {
+        std::string m_uuid;
+        int         m_kind;
+        int         m_net;
+        int         m_layer;
+    };
+
+    struct EVENT_ENTRY
+    {
+        EVENT_TYPE            m_type;
+        VECTOR2I              m_pos;
+        int                   m_arg;    ///> layer, drag mode or "force finish" flag
+        std::vector<ITEM_REF> m_items;
+    };
+
     LOGGER();
     ~LOGGER();
 
@@ -53,6 +91,34 @@ public:
     void Log( const VECTOR2I& aStart, const VECTOR2I& aEnd, int aKind = 0,
               const std::string& aName = std::string() );
 
+    /**
+     * Session recording. A session log starts with the items of the world the router
+     * works on (LogNode()), followed by the router settings and the events fed to the
+     * router, and usually ends with the resulting world, so a replay can be verified.
+     * Each later synchronization of the world with the board is recorded as a hash of
+     * the world (LogSync()), as the replay has to keep its own world.
+     */
+    void LogNode( const NODE* aNode, const std::string& aName );
+    void LogSync( const NODE* aNode );
+    void LogSettings( int aRouterMode, ROUTING_SETTINGS& aSettings, const SIZES_SETTINGS& aSizes );
+    void LogEvent( EVENT_TYPE aType, const VECTOR2I& aPos, const std::vector<ITEM*>& aItems,
+                   int aArg = 0 );
+
+    const std::string GetLog() const { return m_theLog.str(); }
+
+    ///> Parse a "settings" line written by LogSettings().
+    static bool ParseSettings( const std::string& aLine, int& aRouterMode,
+                               ROUTING_SETTINGS& aSettings, SIZES_SETTINGS& aSizes );
+
+    ///> Parse an "event" line written by LogEvent().
+    static bool ParseEvent( const std::string& aLine, EVENT_ENTRY& aEvent );
+
+    ///> Returns the (sorted) item lines LogNode() writes for a node.
+    static std::vector<std::string> FormatNode( const NODE* aNode );
+
+    ///> Hash of the item lines of a node, as written by LogSync().
+    static uint64_t HashNode( const std::vector<std::string>& aItemLines );
+
 private:
     void dumpShape( const SHAPE* aSh );
 
@@ -44,10 +44,14 @@ namespace PNS {
 static std::unordered_set<NODE*> allocNodes;
 #endif
 
+const int NODE::MAX_OVERLAY_DEPTH = 8;
+
 NODE::NODE()
 {
     wxLogTrace( "PNS", "NODE::create %p", this );
     m_depth = 0;
+    m_overlayDepth = 0;
+    m_flattened = false;
     m_root = this;
     m_parent = NULL;
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
@@ -117,18 +121,13 @@ NODE* NODE::Branch()
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
 
-    // Immmediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
-    if( !isRoot() )
-    {
-        JOINT_MAP::iterator j;
+    // The child starts empty and looks up the items, joints and overrides it does not
+    // have in this node. Every query has to visit the whole chain of such nodes, so once
+    // it gets too long, the child takes a flat copy of the parent's state instead.
+    child->m_overlayDepth = isRoot() ? 1 : m_overlayDepth + 1;
 
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
-        child->m_joints = m_joints;
-        child->m_override = m_override;
-    }
+    if( child->m_overlayDepth > MAX_OVERLAY_DEPTH )
+        child->flatten();
 
     wxLogTrace( "PNS", "%d items, %d joints, %d overrides",
             child->m_index->Size(), (int) child->m_joints.size(), (int) child->m_override.size() );
@@ -137,6 +136,144 @@ NODE* NODE::Branch()
 }
 
 
+void NODE::flatten()
+{
+    NODE* base = overlayParent();
+
+    if( !base )
+        return;
+
+    ITEM_VECTOR inherited;
+    base->branchItems( inherited );
+
+    for( ITEM* item : inherited )
+    {
+        if( m_override.find( item ) == m_override.end() )
+            m_index->Add( item );
+    }
+
+    // Overridden items of the other branches are now simply not indexed here, only the
+    // overrides of the root items have to be kept (including those made by the base branches)
+    for( auto i = m_override.begin(); i != m_override.end(); )
+    {
+        if( (*i)->BelongsTo( m_root ) )
+            ++i;
+        else
+            i = m_override.erase( i );
+    }
+
+    for( NODE* node = base; node; node = node->overlayParent() )
+    {
+        for( ITEM* item : node->m_override )
+        {
+            if( item->BelongsTo( m_root ) )
+                m_override.insert( item );
+        }
+    }
+
+    // Joints touched or removed in this node take precedence over the inherited ones
+    std::unordered_set<JOINT::HASH_TAG, JOINT::JOINT_TAG_HASH> localTags( m_removedJoints.begin(),
+                                                                         m_removedJoints.end() );
+
+    for( const TagJointPair& j : m_joints )
+        localTags.insert( j.first );
+
+    std::vector<JOINT*> joints;
+    base->branchJoints( joints );
+
+    for( JOINT* jt : joints )
+    {
+        if( localTags.find( jt->Tag() ) == localTags.end() )
+            m_joints.insert( TagJointPair( jt->Tag(), *jt ) );
+    }
+
+    m_removedJoints.clear();
+    m_flattened = true;
+    m_overlayDepth = 1;
+}
+
+
+void NODE::detachChildren()
+{
+    if( isRoot() )
+        return;
+
+    for( NODE* child : m_children )
+    {
+        if( child->overlayParent() == this )
+            child->flatten();
+    }
+}
+
+
+bool NODE::Overrides( ITEM* aItem ) const
+{
+    for( const NODE* node = this; node; node = node->overlayParent() )
+    {
+        if( node->m_override.find( aItem ) != node->m_override.end() )
+            return true;
+    }
+
+    return false;
+}
+
+
+void NODE::branchItems( ITEM_VECTOR& aItems ) const
+{
+    for( ITEM* item : *m_index )
+        aItems.push_back( item );
+
+    for( const NODE* node = overlayParent(); node; node = node->overlayParent() )
+    {
+        for( ITEM* item : *node->m_index )
+        {
+            if( !Overrides( item ) )
+                aItems.push_back( item );
+        }
+    }
+}
+
+
+void NODE::branchJoints( std::vector<JOINT*>& aJoints )
+{
+    // A tag found in a node hides the joints with the same tag in the nodes further up
+    // the chain, so does a tag removed in a node.
+    std::unordered_set<JOINT::HASH_TAG, JOINT::JOINT_TAG_HASH> seenTags;
+
+    for( NODE* node = this; node && !node->isRoot(); node = node->overlayParent() )
+    {
+        std::vector<JOINT::HASH_TAG> nodeTags;
+
+        for( TagJointPair& j : node->m_joints )
+        {
+            if( seenTags.find( j.first ) != seenTags.end() )
+                continue;
+
+            nodeTags.push_back( j.first );
+            aJoints.push_back( &j.second );
+        }
+
+        seenTags.insert( nodeTags.begin(), nodeTags.end() );
+        seenTags.insert( node->m_removedJoints.begin(), node->m_removedJoints.end() );
+    }
+}
+
+
+NODE::JOINT_MAP& NODE::jointMap( const JOINT::HASH_TAG& aTag )
+{
+    for( NODE* node = this; node && !node->isRoot(); node = node->overlayParent() )
+    {
+        if( node->m_joints.find( aTag ) != node->m_joints.end() )
+            return node->m_joints;
+
+        if( node->m_removedJoints.find( aTag ) != node->m_removedJoints.end() )
+            break;
+    }
+
+    return m_root->m_joints;
+}
+
+
 void NODE::unlinkParent()
 {
     if( isRoot() )
@@ -264,6 +401,13 @@ int NODE::QueryColliding( const ITEM* aItem, OBSTACLE_VISITOR& aVisitor )
     aVisitor.SetWorld( this, NULL );
     m_index->Query( aItem, m_maxClearance, aVisitor );
 
+    // look in the branches this one is based on
+    for( NODE* node = overlayParent(); node; node = node->overlayParent() )
+    {
+        aVisitor.SetWorld( node, this );
+        node->m_index->Query( aItem, m_maxClearance, aVisitor );
+    }
+
     // if we haven't found enough items, look in the root branch as well.
     if( !isRoot() )
     {
@@ -287,14 +431,28 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles, int aK
     visitor.SetCountLimit( aLimitCount );
     visitor.SetWorld( this, NULL );
     visitor.m_forceClearance = aForceClearance;
+
+    // Items of the same net never collide with aItem, let the index skip them altogether
+    int excludeNet = ( aDifferentNetsOnly && aItem->Net() >= 0 ) ? aItem->Net() : -1;
+
     // first, look for colliding items in the local index
-    m_index->Query( aItem, m_maxClearance, visitor );
+    m_index->Query( aItem, m_maxClearance, visitor, excludeNet );
+
+    // then in the branches this one is based on
+    for( NODE* node = overlayParent(); node; node = node->overlayParent() )
+    {
+        if( aLimitCount > 0 && visitor.m_matchCount >= aLimitCount )
+            break;
+
+        visitor.SetWorld( node, this );
+        node->m_index->Query( aItem, m_maxClearance, visitor, excludeNet );
+    }
 
     // if we haven't found enough items, look in the root branch as well.
     if( !isRoot() && ( visitor.m_matchCount < aLimitCount || aLimitCount < 0 ) )
     {
         visitor.SetWorld( m_root, this );
-        m_root->m_index->Query( aItem, m_maxClearance, visitor );
+        m_root->m_index->Query( aItem, m_maxClearance, visitor, excludeNet );
     }
 
     return aObstacles.size();
@@ -523,6 +681,10 @@ const ITEM_SET NODE::HitTest( const VECTOR2I& aPoint ) const
         ITEM_SET items_root;
         visitor.SetWorld( m_root, NULL );
         HIT_VISITOR  visitor_root( items_root, aPoint );
+
+        for( NODE* node = overlayParent(); node; node = node->overlayParent() )
+            node->m_index->Query( &s, m_maxClearance, visitor_root );
+
         m_root->m_index->Query( &s, m_maxClearance, visitor_root );
 
         for( ITEM* item : items_root.Items() )
@@ -538,6 +700,8 @@ const ITEM_SET NODE::HitTest( const VECTOR2I& aPoint ) const
 
 void NODE::addSolid( SOLID* aSolid )
 {
+    detachChildren();
+
     if( aSolid->IsRoutable() )
         linkJoint( aSolid->Pos(), aSolid->Layers(), aSolid->Net(), aSolid );
 
@@ -552,6 +716,8 @@ void NODE::Add( std::unique_ptr< SOLID > aSolid )
 
 void NODE::addVia( VIA* aVia )
 {
+    detachChildren();
+
     linkJoint( aVia->Pos(), aVia->Layers(), aVia->Net(), aVia );
     m_index->Add( aVia );
 }
@@ -611,6 +777,8 @@ void NODE::Add( LINE& aLine, bool aAllowRedundant )
 
 void NODE::addSegment( SEGMENT* aSeg )
 {
+    detachChildren();
+
     linkJoint( aSeg->Seg().A, aSeg->Layers(), aSeg->Net(), aSeg );
     linkJoint( aSeg->Seg().B, aSeg->Layers(), aSeg->Net(), aSeg );
 
@@ -636,6 +804,8 @@ bool NODE::Add( std::unique_ptr< SEGMENT > aSegment, bool aAllowRedundant )
 
 void NODE::addArc( ARC* aArc )
 {
+    detachChildren();
+
     linkJoint( aArc->Anchor( 0 ), aArc->Layers(), aArc->Net(), aArc );
     linkJoint( aArc->Anchor( 1 ), aArc->Layers(), aArc->Net(), aArc );
 
@@ -670,15 +840,23 @@ void NODE::Add( std::unique_ptr< ITEM > aItem, bool aAllowRedundant )
 
 void NODE::doRemove( ITEM* aItem )
 {
+    detachChildren();
+
     // case 1: removing an item that is stored in the root node from any branch:
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
         m_override.insert( aItem );
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
-    // or the root itself and we are the root: remove from the index
+    // or the root itself and we are the root: remove from the index (or override it,
+    // if it is stored in one of the branches this one is based on)
     else if( !aItem->BelongsTo( m_root ) || isRoot() )
-        m_index->Remove( aItem );
+    {
+        if( isRoot() || m_index->Contains( aItem ) )
+            m_index->Remove( aItem );
+        else
+            m_override.insert( aItem );
+    }
 
     // the item belongs to this particular branch: un-reference it
     if( aItem->BelongsTo( this ) )
@@ -715,6 +893,22 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
     tag.net = net;
     tag.pos = aJoint->Pos();
 
+    detachChildren();
+
+    // The joint may be stored in one of the branches this one is based on: split a local copy
+    if( !isRoot() && m_joints.find( tag ) == m_joints.end() )
+    {
+        JOINT_MAP& joints = jointMap( tag );
+
+        if( &joints != &m_root->m_joints )
+        {
+            auto range = joints.equal_range( tag );
+
+            for( auto f = range.first; f != range.second; ++f )
+                m_joints.insert( *f );
+        }
+    }
+
     bool split;
     do
     {
@@ -737,6 +931,9 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
         }
     } while( split );
 
+    if( !isRoot() && m_joints.find( tag ) == m_joints.end() )
+        m_removedJoints.insert( tag );
+
     // and re-link them, using the former via's link list
     for(ITEM* link : links)
     {
@@ -1031,13 +1228,8 @@ JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, int aNet )
     tag.net = aNet;
     tag.pos = aPos;
 
-    JOINT_MAP::iterator f = m_joints.find( tag ), end = m_joints.end();
-
-    if( f == end && !isRoot() )
-    {
-        end = m_root->m_joints.end();
-        f = m_root->m_joints.find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
-    }
+    JOINT_MAP& joints = jointMap( tag );
+    JOINT_MAP::iterator f = joints.find( tag ), end = joints.end();
 
     if( f == end )
         return NULL;
@@ -1068,18 +1260,23 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
     tag.pos = aPos;
     tag.net = aNet;
 
+    detachChildren();
+
     // try to find the joint in this node.
     JOINT_MAP::iterator f = m_joints.find( tag );
 
     std::pair<JOINT_MAP::iterator, JOINT_MAP::iterator> range;
 
-    // not found and we are not root? find in the root and copy results here.
+    // not found and we are not root? find in the branch this node is based on (or
+    // in the root) and copy results here.
     if( f == m_joints.end() && !isRoot() )
     {
-        range = m_root->m_joints.equal_range( tag );
+        range = jointMap( tag ).equal_range( tag );
 
         for( f = range.first; f != range.second; ++f )
             m_joints.insert( *f );
+
+        m_removedJoints.erase( tag );
     }
 
     // now insert and combine overlapping joints
@@ -1224,17 +1421,19 @@ void NODE::GetUpdatedItems( ITEM_VECTOR& aRemoved, ITEM_VECTOR& aAdded )
     if( isRoot() )
         return;
 
-    if( m_override.size() )
-        aRemoved.reserve( m_override.size() );
-    
-    if( m_index->Size() )
-        aAdded.reserve( m_index->Size() );
+    std::unordered_set<ITEM*> removed;
 
-    for( ITEM* item : m_override )
-        aRemoved.push_back( item );
+    // Items of the non-root branches hidden in this one are simply not reported as added
+    for( const NODE* node = this; node; node = node->overlayParent() )
+    {
+        for( ITEM* item : node->m_override )
+        {
+            if( item->BelongsTo( m_root ) && removed.insert( item ).second )
+                aRemoved.push_back( item );
+        }
+    }
 
-    for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
-        aAdded.push_back( *i );
+    branchItems( aAdded );
 }
 
 void NODE::releaseChildren()
@@ -1270,14 +1469,17 @@ void NODE::Commit( NODE* aNode )
         if( aNode->isRoot() )
             return;
 
-        for( ITEM* item : aNode->m_override )
+        ITEM_VECTOR removed, added;
+        aNode->GetUpdatedItems( removed, added );
+
+        for( ITEM* item : removed )
             Remove( item );
 
-        for( auto i : *aNode->m_index )
+        for( ITEM* item : added )
         {
-            i->SetRank( -1 );
-            i->Unmark();
-            Add( std::unique_ptr<ITEM>( i ) );
+            item->SetRank( -1 );
+            item->Unmark();
+            Add( std::unique_ptr<ITEM>( item ) );
         }
 
         releaseChildren();
@@ -1301,6 +1503,20 @@ void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems )
             aItems.insert( item );
     }
 
+    for( NODE* node = overlayParent(); node; node = node->overlayParent() )
+    {
+        INDEX::NET_ITEMS_LIST* l_branch = node->m_index->GetItemsForNet( aNet );
+
+        if( l_branch )
+        {
+            for( ITEM* item : *l_branch )
+            {
+                if( !Overrides( item ) )
+                    aItems.insert( item );
+            }
+        }
+    }
+
     if( !isRoot() )
     {
         INDEX::NET_ITEMS_LIST* l_root = m_root->m_index->GetItemsForNet( aNet );
@@ -1313,12 +1529,30 @@ void NODE::AllItemsInNet( int aNet, std::set<ITEM*>& aItems )
 }
 
 
+void NODE::AllItems( ITEM_VECTOR& aItems ) const
+{
+    branchItems( aItems );
+
+    if( isRoot() )
+        return;
+
+    for( ITEM* item : *m_root->m_index )
+    {
+        if( !Overrides( item ) )
+            aItems.push_back( item );
+    }
+}
+
+
 void NODE::ClearRanks( int aMarkerMask )
 {
-    for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
+    ITEM_VECTOR items;
+    branchItems( items );
+
+    for( ITEM* item : items )
     {
-        (*i)->SetRank( -1 );
-        (*i)->Mark( (*i)->Marker() & (~aMarkerMask) );
+        item->SetRank( -1 );
+        item->Mark( item->Marker() & (~aMarkerMask) );
     }
 }
 
@@ -1326,8 +1560,11 @@ void NODE::ClearRanks( int aMarkerMask )
 void NODE::RemoveByMarker( int aMarker )
 {
     std::list<ITEM*> garbage;
+    ITEM_VECTOR      items;
 
-    for( ITEM* item : *m_index )
+    branchItems( items );
+
+    for( ITEM* item : items )
     {
         if( item->Marker() & aMarker )
             garbage.push_back( item );
@@ -1410,18 +1647,31 @@ int NODE::QueryJoints( const BOX2I& aBox,
 
     aJoints.clear();
 
-    for( auto j = m_joints.begin(); j != m_joints.end(); ++j )
+    std::vector<JOINT*> branchJointList;
+    branchJoints( branchJointList );
+
+    for( JOINT* jt : branchJointList )
     {
-        if ( aBox.Contains(j->second.Pos()) && j->second.LinkCount ( aKindMask ) )
+        if ( aBox.Contains( jt->Pos() ) && jt->LinkCount( aKindMask ) )
         {
-            aJoints.push_back( &j->second );
+            aJoints.push_back( jt );
             n++;
-
         }
     }
 
     if ( isRoot() )
+    {
+        for( auto j = m_joints.begin(); j != m_joints.end(); ++j )
+        {
+            if ( aBox.Contains(j->second.Pos()) && j->second.LinkCount ( aKindMask ) )
+            {
+                aJoints.push_back( &j->second );
+                n++;
+            }
+        }
+
         return n;
+    }
 
     for( auto j = m_root->m_joints.begin(); j != m_root->m_joints.end(); ++j )
     {
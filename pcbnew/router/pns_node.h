@@ -332,6 +332,10 @@ public:
      * Creates a lightweight copy (called branch) of self that tracks
      * the changes (added/removed items) wrs to the root. Note that if there are
      * any branches in use, their parents must NOT be deleted.
+     *
+     * The branch stores only its own changes and looks up everything else in the
+     * branch it was created from, so branching does not copy the parent's items or joints.
+     * If the parent is modified later, its children take a copy of its state first.
      * @return the new branch
      */
     NODE* Branch();
@@ -412,6 +416,9 @@ public:
 
     void AllItemsInNet( int aNet, std::set<ITEM*>& aItems );
 
+    ///> returns all the items visible in this branch (including the root items)
+    void AllItems( ITEM_VECTOR& aItems ) const;
+
     void ClearRanks( int aMarkerMask = MK_HEAD | MK_VIOLATION );
 
     void RemoveByMarker( int aMarker );
@@ -430,11 +437,8 @@ public:
     }
 
     ///> checks if this branch contains an updated version of the m_item
-    ///> from the root branch.
-    bool Overrides( ITEM* aItem ) const
-    {
-        return m_override.find( aItem ) != m_override.end();
-    }
+    ///> from the root branch (or from one of the branches it is based on).
+    bool Overrides( ITEM* aItem ) const;
 
 private:
     struct DEFAULT_OBSTACLE_VISITOR;
@@ -479,6 +483,31 @@ private:
         return m_parent == NULL;
     }
 
+    ///> returns the branch this node stores its changes against (NULL if it is the root)
+    NODE* overlayParent() const
+    {
+        if( m_flattened || isRoot() || m_parent->isRoot() )
+            return NULL;
+
+        return m_parent;
+    }
+
+    ///> returns the joint map holding the joints with a given tag, as seen from this branch
+    JOINT_MAP& jointMap( const JOINT::HASH_TAG& aTag );
+
+    ///> collects the items stored in this branch and the branches it is based on (for the
+    ///> root: all items)
+    void branchItems( ITEM_VECTOR& aItems ) const;
+
+    ///> collects the joints stored in this branch and the branches it is based on
+    void branchJoints( std::vector<JOINT*>& aJoints );
+
+    ///> copies the state of the branches this one is based on, making it independent of them
+    void flatten();
+
+    ///> makes the children independent of this node before it gets modified
+    void detachChildren();
+
     SEGMENT* findRedundantSegment( const VECTOR2I& A, const VECTOR2I& B,
                                    const LAYER_RANGE & lr, int aNet );
     SEGMENT* findRedundantSegment( SEGMENT* aSeg );
@@ -504,9 +533,22 @@ private:
     ///> list of nodes branched from this one
     std::set<NODE*> m_children;
 
-    ///> hash of root's items that have been changed in this node
+    ///> hash of root's items (or items of the branches this one is based on)
+    ///> that have been changed in this node
     std::unordered_set<ITEM*> m_override;
 
+    ///> tags of the joints removed in this node (lookups fall back to the root for them)
+    std::unordered_set<JOINT::HASH_TAG, JOINT::JOINT_TAG_HASH> m_removedJoints;
+
+    ///> number of branches searched by the queries, including this one
+    int m_overlayDepth;
+
+    ///> true if the node holds a copy of its parent's state instead of referring to it
+    bool m_flattened;
+
+    ///> maximum number of branches searched by the queries before a branch gets flattened
+    static const int MAX_OVERLAY_DEPTH;
+
     ///> worst case item-item clearance
     int m_maxClearance;
 
@@ -55,6 +55,7 @@
 #include "pns_meander_placer.h"
 #include "pns_meander_skew_placer.h"
 #include "pns_dp_meander_placer.h"
+#include "pns_logger.h"
 
 namespace PNS {
 
@@ -77,6 +78,7 @@ ROUTER::ROUTER()
     m_snapshotIter = 0;
     m_violation = false;
     m_iface = nullptr;
+    m_sessionLogger = nullptr;
 }
 
 
@@ -100,6 +102,14 @@ void ROUTER::SyncWorld()
     m_world = std::make_unique<NODE>( );
     m_iface->SyncWorld( m_world.get() );
 
+    if( m_sessionLogger )
+    {
+        if( m_sessionLogger->GetLog().empty() )
+            m_sessionLogger->LogNode( m_world.get(), "world" );
+        else
+            m_sessionLogger->LogSync( m_world.get() );
+    }
+
 }
 
 void ROUTER::ClearWorld()
@@ -136,6 +146,17 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aItem, int aDragMode )
 
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM_SET aStartItems, int aDragMode )
 {
+    if( m_sessionLogger )
+    {
+        std::vector<ITEM*> items;
+
+        for( int i = 0; i < aStartItems.Size(); i++ )
+            items.push_back( aStartItems[i] );
+
+        m_sessionLogger->LogSettings( m_mode, Settings(), m_sizes );
+        m_sessionLogger->LogEvent( LOGGER::EVT_START_DRAG, aP, items, aDragMode );
+    }
+
     if( aStartItems.Empty() )
         return false;
 
@@ -189,7 +210,12 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer )
 }
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
-{   
+{
+    if( m_sessionLogger )
+    {
+        m_sessionLogger->LogSettings( m_mode, Settings(), m_sizes );
+        m_sessionLogger->LogEvent( LOGGER::EVT_START_ROUTE, aP, { aStartItem }, aLayer );
+    }
 
     if( ! isStartingPointRoutable( aP, aLayer ) )
     {
@@ -245,6 +271,9 @@ void ROUTER::DisplayItems( const ITEM_SET& aItems )
 
 void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_MOVE, aP, { endItem } );
+
     m_currentEnd = aP;
 
     switch( m_state )
@@ -333,6 +362,9 @@ void ROUTER::UpdateSizes( const SIZES_SETTINGS& aSizes )
 {
     m_sizes = aSizes;
 
+    if( m_sessionLogger && m_settings )
+        m_sessionLogger->LogSettings( m_mode, Settings(), m_sizes );
+
     // Change track/via size settings
     if( m_state == ROUTE_TRACK)
     {
@@ -392,6 +424,9 @@ bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish )
 {
     bool rv = false;
 
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_FIX, aP, { aEndItem }, aForceFinish ? 1 : 0 );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -415,12 +450,18 @@ void ROUTER::UndoLastSegment()
     if( !RoutingInProgress() )
         return;
 
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_UNFIX, m_currentEnd, {} );
+
     m_placer->UnfixRoute();
 }
 
 
 void ROUTER::CommitRouting()
 {
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_COMMIT, m_currentEnd, {} );
+
     if( m_state == ROUTE_TRACK )
         m_placer->CommitPlacement();
 
@@ -445,6 +486,9 @@ void ROUTER::StopRouting()
     if( !RoutingInProgress() )
         return;
 
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_ABORT, m_currentEnd, {} );
+
     m_placer.reset();
     m_dragger.reset();
 
@@ -458,6 +502,9 @@ void ROUTER::StopRouting()
 
 void ROUTER::FlipPosture()
 {
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_FLIP_POSTURE, m_currentEnd, {} );
+
     if( m_state == ROUTE_TRACK )
     {
         m_placer->FlipPosture();
@@ -467,6 +514,9 @@ void ROUTER::FlipPosture()
 
 void ROUTER::SwitchLayer( int aLayer )
 {
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_SWITCH_LAYER, m_currentEnd, {}, aLayer );
+
     switch( m_state )
     {
     case ROUTE_TRACK:
@@ -480,6 +530,9 @@ void ROUTER::SwitchLayer( int aLayer )
 
 void ROUTER::ToggleViaPlacement()
 {
+    if( m_sessionLogger )
+        m_sessionLogger->LogEvent( LOGGER::EVT_TOGGLE_VIA, m_currentEnd, {} );
+
     if( m_state == ROUTE_TRACK )
     {
         bool toggle = !m_placer->IsPlacingVia();
@@ -528,6 +581,40 @@ void ROUTER::DumpLog()
 }
 
 
+void ROUTER::SetSessionLogger( LOGGER* aLogger )
+{
+    m_sessionLogger = aLogger;
+
+    if( m_sessionLogger && m_world )
+    {
+        m_sessionLogger->Clear();
+        m_sessionLogger->LogNode( m_world.get(), "world" );
+    }
+}
+
+
+void ROUTER::SaveSession( const std::string& aFilename )
+{
+    if( !m_sessionLogger || !m_world )
+        return;
+
+    LOGGER result;
+    result.LogNode( m_world.get(), "final" );
+
+    FILE* f = fopen( aFilename.c_str(), "wb" );
+
+    if( !f )
+        return;
+
+    const std::string session = m_sessionLogger->GetLog();
+    const std::string world = result.GetLog();
+
+    fwrite( session.c_str(), 1, session.length(), f );
+    fwrite( world.c_str(), 1, world.length(), f );
+    fclose( f );
+}
+
+
 bool ROUTER::IsPlacingVia() const
 {
     if( !m_placer )
@@ -58,6 +58,7 @@ class LINE;
 class SOLID;
 class SEGMENT;
 class JOINT;
+class LOGGER;
 class VIA;
 class RULE_RESOLVER;
 class SHOVE;
@@ -171,6 +172,17 @@ public:
 
     void DumpLog();
 
+    /**
+     * Records the routing session (the world, the settings and all the events passed to
+     * the router) in aLogger, so it can be replayed later without the GUI.  NULL stops
+     * recording.
+     */
+    void SetSessionLogger( LOGGER* aLogger );
+    LOGGER* SessionLogger() const { return m_sessionLogger; }
+
+    ///> Saves the recorded session, followed by the current state of the world.
+    void SaveSession( const std::string& aFilename );
+
     RULE_RESOLVER* GetRuleResolver() const
     {
         return m_iface->GetRuleResolver();
@@ -270,6 +282,7 @@ private:
     std::unique_ptr< SHOVE >          m_shove;
 
     ROUTER_IFACE* m_iface;
+    LOGGER*       m_sessionLogger;
 
     int m_iterLimit;
     bool m_showInterSteps;
@@ -24,6 +24,8 @@
 #include <functional>
 using namespace std::placeholders;
 
+#include <advanced_config.h>
+
 #include "class_draw_panel_gal.h"
 #include "class_board.h"
 
@@ -54,6 +56,7 @@ using namespace std::placeholders;
 #include "pns_meander_placer.h" // fixme: move settings to separate header
 #include "pns_tune_status_popup.h"
 #include "pns_topology.h"
+#include "pns_logger.h"
 
 #include <view/view.h>
 
@@ -103,6 +106,13 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
 
     m_router = new ROUTER;
     m_router->SetInterface( m_iface );
+
+    if( !ADVANCED_CFG::GetCfg().m_RouterSessionLog.IsEmpty() )
+    {
+        m_sessionLogger = std::make_unique<LOGGER>();
+        m_router->SetSessionLogger( m_sessionLogger.get() );
+    }
+
     m_router->ClearWorld();
     m_router->SyncWorld();
 
@@ -390,6 +400,15 @@ ROUTER *TOOL_BASE::Router() const
 }
 
 
+void TOOL_BASE::saveRouterSession()
+{
+    const wxString& filename = ADVANCED_CFG::GetCfg().m_RouterSessionLog;
+
+    if( m_sessionLogger && !filename.IsEmpty() )
+        m_router->SaveSession( filename.ToStdString() );
+}
+
+
 const VECTOR2I TOOL_BASE::snapToItem( bool aEnabled, ITEM* aItem, VECTOR2I aP)
 {
     VECTOR2I anchor;
@@ -61,6 +61,9 @@ protected:
     virtual void updateEndItem( const TOOL_EVENT& aEvent );
     void deleteTraces( ITEM* aStartItem, bool aWholeTrack );
 
+    ///> Saves the router session, if session recording is enabled in the advanced config.
+    void saveRouterSession();
+
     MSG_PANEL_ITEMS m_panelItems;
 
     SIZES_SETTINGS m_savedSizes;          ///< Stores sizes settings between router invocations
@@ -76,6 +79,8 @@ protected:
     PNS_KICAD_IFACE* m_iface;
     ROUTER* m_router;
 
+    std::unique_ptr<LOGGER> m_sessionLogger;
+
     bool m_cancelled;
 };
 
@@ -19,6 +19,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <core/optional.h>
 
 #include <geometry/shape_line_chain.h>
@@ -153,7 +157,7 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
 
 
 
-bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
+bool clipToLoopStart( SHAPE_LINE_CHAIN& l, DEBUG_DECORATOR* aDbg )
 {
     auto ip = l.SelfIntersecting();
 
@@ -166,8 +170,8 @@ bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
 
         int pidx2 = tail.Split( ip->p );
         
-        auto dbg = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
-        dbg->AddPoint( ip->p, 5 );
+        if( aDbg )
+            aDbg->AddPoint( ip->p, 5 );
         
         l = lead;
         l.Append( tail.Slice( 0, pidx2 ) );
@@ -180,8 +184,79 @@ bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
 
 
 
+const WALKAROUND::RESULT WALKAROUND::routeConcurrently( const LINE& aInitialPath )
+{
+    // The clockwise and counter-clockwise walks don't depend on each other: each one runs
+    // in its own copy of the walker (the world is only queried, never modified).
+    const bool windings[2] = { true, false };
+    std::vector<WALKAROUND> walkers( 2, *this );
+    RESULT results[2];
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        walkers[ii].SetForceWinding( true, windings[ii] );
+
+        // Debug output and logging are not thread-safe
+        walkers[ii].SetDebugDecorator( nullptr );
+        walkers[ii].SetLogger( nullptr );
+    }
+
+    std::atomic<size_t> nextWalk( 0 );
+
+    auto walk_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t ii = nextWalk++; ii < walkers.size(); ii = nextWalk++ )
+        {
+            results[ii] = walkers[ii].Route( aInitialPath );
+            num++;
+        }
+
+        return num;
+    };
+
+    // The calling thread takes part, so one worker is enough for the two walks
+    std::future<size_t> worker = std::async( std::launch::async, walk_lambda );
+
+    walk_lambda();
+    worker.wait();
+
+    RESULT result = results[0];
+
+    result.lineCcw = results[1].lineCcw;
+    result.statusCcw = results[1].statusCcw;
+
+    return result;
+}
+
+
+bool WALKAROUND::IsCcwPreferred( const LINE& aCw, const LINE& aCcw )
+{
+    LINE           cw( aCw ), ccw( aCcw );
+    COST_ESTIMATOR cost_cw, cost_ccw;
+
+    cost_cw.Add( cw );
+    cost_ccw.Add( ccw );
+
+    // The candidate with cheaper corners wins unless it's noticeably longer
+    if( cost_cw.IsBetter( cost_ccw, 1.1, 1.0 ) )
+        return true;
+    else if( cost_ccw.IsBetter( cost_cw, 1.1, 1.0 ) )
+        return false;
+
+    return aCcw.CLine().Length() < aCw.CLine().Length();
+}
+
+
 const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 {
+    if( !m_forceWinding && aInitialPath.PointCount() > 1
+            && std::thread::hardware_concurrency() > 1 )
+    {
+        return routeConcurrently( aInitialPath );
+    }
+
     LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
     SHAPE_LINE_CHAIN best_path;
@@ -228,14 +303,14 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
         
         auto old = path_cw.CLine();
 
-        if( clipToLoopStart( path_cw.Line() ))
+        if( clipToLoopStart( path_cw.Line(), Dbg() ))
         {
             //printf("ClipCW\n");
             //Dbg()->AddLine( old, 1, 40000 );
             s_cw = ALMOST_DONE;
         }
 
-        if( clipToLoopStart( path_ccw.Line() ))
+        if( clipToLoopStart( path_ccw.Line(), Dbg() ))
         {
             //printf("ClipCCW\n");
             s_ccw = ALMOST_DONE;
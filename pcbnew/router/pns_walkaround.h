@@ -137,11 +137,24 @@ public:
     WALKAROUND_STATUS Route( const LINE& aInitialPath, LINE& aWalkPath,
             bool aOptimize = true );
 
+    /**
+     * Walks around the obstacles in both winding directions. Unless a winding is forced,
+     * the two directions are walked concurrently.
+     */
     const RESULT Route( const LINE& aInitialPath );
 
+    /**
+     * Chooses between the two candidates of a walkaround: the one with cheaper corners unless
+     * it is noticeably longer, otherwise the shorter one.
+     * @return true if the counter-clockwise candidate should be used.
+     */
+    static bool IsCcwPreferred( const LINE& aCw, const LINE& aCcw );
+
 private:
     void start( const LINE& aInitialPath );
 
+    const RESULT routeConcurrently( const LINE& aInitialPath );
+
     WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
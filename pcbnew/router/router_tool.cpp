@@ -757,6 +757,7 @@ bool ROUTER_TOOL::prepareInteractive()
 bool ROUTER_TOOL::finishInteractive()
 {
     m_router->StopRouting();
+    saveRouterSession();
 
     controls()->SetAutoPan( false );
     controls()->ForceCursorPosition( false );
@@ -1101,6 +1102,7 @@ void ROUTER_TOOL::performDragging( int aMode )
     if( m_router->RoutingInProgress() )
         m_router->StopRouting();
 
+    saveRouterSession();
     m_startItem = nullptr;
 
     m_gridHelper->SetAuxAxes( false );
@@ -1280,6 +1282,7 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     if( m_router->RoutingInProgress() )
         m_router->StopRouting();
 
+    saveRouterSession();
     m_gridHelper->SetAuxAxes( false );
     controls()->SetAutoPan( false );
     controls()->ForceCursorPosition( false );
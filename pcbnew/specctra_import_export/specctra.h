@@ -36,7 +36,10 @@
 #include <specctra_import_export/specctra_lexer.h>
 #include <pcbnew.h>
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 // all outside the DSN namespace:
 class BOARD;
@@ -211,16 +214,15 @@ protected:
      */
     std::string makeHash()
     {
-        sf.Clear();
+        // a local formatter, so hashes can be built from several threads.
+        STRING_FORMATTER sf;
+
         FormatContents( &sf, 0 );
         sf.StripUseless();
 
         return sf.GetString();
     }
 
-    // avoid creating this for every compare, make static.
-    static STRING_FORMATTER  sf;
-
 
 public:
 
@@ -2238,12 +2240,18 @@ class LIBRARY : public ELEM
     PADSTACKS       padstacks;      ///< all except vias, which are in 'vias'
     PADSTACKS       vias;
 
+    /// LookupIMAGE() index of the images by hash, and count of the images by image_id.
+    std::unordered_map<std::string, unsigned> imageIndex;
+    std::map<std::string, int>                imageIdCount;
+    unsigned                                  imagesIndexed;
+
 public:
 
     LIBRARY( ELEM* aParent, DSN_T aType = T_library ) :
         ELEM( aType, aParent )
     {
         unit = 0;
+        imagesIndexed = 0;
 //        via_start_index = -1;       // 0 or greater means there is at least one via
     }
     ~LIBRARY()
@@ -2309,20 +2317,43 @@ public:
     /**
      * Function LookupIMAGE
      * will add the image only if one exactly like it does not already exist
-     * in the image container.
+     * in the image container.  Gives the same result as FindIMAGE(), but
+     * searches the images by hash rather than comparing them one by one.
      * @return IMAGE* - the IMAGE which is registered in the LIBRARY that
      *           matches the argument, and it will be either the argument or
      *           a previous image which is a duplicate.
      */
     IMAGE* LookupIMAGE( IMAGE* aImage )
     {
-        int ndx = FindIMAGE( aImage );
-        if( ndx == -1 )
+        // index the images appended since the previous lookup
+        for( ; imagesIndexed < images.size(); ++imagesIndexed )
         {
-            AppendIMAGE( aImage );
-            return aImage;
+            IMAGE* image = &images[imagesIndexed];
+
+            if( !image->hash.size() )
+                image->hash = image->makeHash();
+
+            imageIndex.emplace( image->hash, imagesIndexed );   // keeps the first one
+            imageIdCount[ image->image_id ]++;
         }
-        return &images[ndx];
+
+        if( !aImage->hash.size() )
+            aImage->hash = aImage->makeHash();
+
+        auto found = imageIndex.find( aImage->hash );
+
+        if( found != imageIndex.end() )
+            return &images[found->second];
+
+        // There is no match to the IMAGE contents, but now generate a unique
+        // name for it.
+        auto dups = imageIdCount.find( aImage->image_id );
+
+        if( dups != imageIdCount.end() )
+            aImage->duplicated = dups->second;
+
+        AppendIMAGE( aImage );
+        return aImage;
     }
 
     /**
@@ -3637,6 +3668,10 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
 
     PADSTACKSET     padstackset;
 
+    /// padstacks of padstackset by padstackKey(), and the lock guarding both.
+    std::unordered_map<std::string, PADSTACK*> padstackCache;
+    std::mutex                                 padstackLock;
+
     /// we don't want ownership here permanently, so we don't use boost::ptr_vector
     std::vector<NET*>   nets;
 
@@ -3781,6 +3816,17 @@ class SPECCTRA_DB : public SPECCTRA_LEXER
      */
     PADSTACK* makePADSTACK( BOARD* aBoard, D_PAD* aPad );
 
+    /**
+     * Function lookupPADSTACK
+     * returns the padstack of padstackset which matches the given pad, calling
+     * makePADSTACK() only for pads unlike any pad seen before.  Can be called
+     * from several threads.
+     * @param aBoard The owner of the MODULE.
+     * @param aPad The D_PAD which needs to be made into a PADSTACK.
+     * @return PADSTACK* - The registered padstack, owned by padstackset.
+     */
+    PADSTACK* lookupPADSTACK( BOARD* aBoard, D_PAD* aPad );
+
     /**
      * Function makeVia
      * makes a round through hole PADSTACK using the given KiCad diameter in deci-mils.
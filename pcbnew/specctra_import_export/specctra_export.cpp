@@ -40,6 +40,9 @@
 
 #include <set>                  // std::set
 #include <map>                  // std::map
+#include <atomic>
+#include <future>
+#include <thread>
 
 #include <class_board.h>
 #include <class_module.h>
@@ -586,6 +589,82 @@ PADSTACK* SPECCTRA_DB::makePADSTACK( BOARD* aBoard, D_PAD* aPad )
 }
 
 
+/**
+ * Function padstackKey
+ * builds a key holding every pad property makePADSTACK() depends on, so
+ * pads with the same key get the same padstack.
+ * @return std::string - the key, empty for custom pads which are not keyed.
+ */
+static std::string padstackKey( D_PAD* aPad )
+{
+    std::string key;
+
+    if( aPad->GetShape() == PAD_SHAPE_CUSTOM )
+        return key;
+
+    auto add = [&key]( int aValue )
+    {
+        key.append( (const char*) &aValue, sizeof( aValue ) );
+    };
+
+    add( aPad->GetShape() );
+    add( aPad->GetSize().x );
+    add( aPad->GetSize().y );
+    add( aPad->GetOffset().x );
+    add( aPad->GetOffset().y );
+    add( aPad->GetDelta().x );
+    add( aPad->GetDelta().y );
+
+    if( aPad->GetShape() == PAD_SHAPE_ROUNDRECT || aPad->GetShape() == PAD_SHAPE_CHAMFERED_RECT )
+    {
+        double ratio = aPad->GetChamferRectRatio();
+
+        add( aPad->GetRoundRectCornerRadius() );
+        add( aPad->GetChamferPositions() );
+        key.append( (const char*) &ratio, sizeof( ratio ) );
+    }
+
+    key += ( aPad->GetLayerSet() & LSET::AllCuMask() ).FmtHex();
+
+    return key;
+}
+
+
+PADSTACK* SPECCTRA_DB::lookupPADSTACK( BOARD* aBoard, D_PAD* aPad )
+{
+    std::string key = padstackKey( aPad );
+
+    std::lock_guard<std::mutex> lock( padstackLock );
+
+    if( !key.empty() )
+    {
+        auto cached = padstackCache.find( key );
+
+        if( cached != padstackCache.end() )
+            return cached->second;
+    }
+
+    PADSTACK*               padstack = makePADSTACK( aBoard, aPad );
+    PADSTACKSET::iterator   iter = padstackset.find( *padstack );
+
+    if( iter != padstackset.end() )
+    {
+        // padstack is a duplicate, delete it and use the original
+        delete padstack;
+        padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
+    }
+    else
+    {
+        padstackset.insert( padstack );
+    }
+
+    if( !key.empty() )
+        padstackCache[ key ] = padstack;
+
+    return padstack;
+}
+
+
 /// data type used to ensure unique-ness of pin names, holding (wxString and int)
 typedef std::map<wxString, int> PINMAP;
 
@@ -643,19 +722,7 @@ IMAGE* SPECCTRA_DB::makeIMAGE( BOARD* aBoard, MODULE* aModule )
             if( !mask_copper_layers.any() )
                 continue;
 
-            PADSTACK*               padstack = makePADSTACK( aBoard, pad );
-            PADSTACKSET::iterator   iter = padstackset.find( *padstack );
-
-            if( iter != padstackset.end() )
-            {
-                // padstack is a duplicate, delete it and use the original
-                delete padstack;
-                padstack = (PADSTACK*) *iter.base();    // folklore, be careful here
-            }
-            else
-            {
-                padstackset.insert( padstack );
-            }
+            PADSTACK* padstack = lookupPADSTACK( aBoard, pad );
 
             PIN* pin = new PIN( image );
 
@@ -1331,12 +1398,42 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
         items.Collect( aBoard, scanMODULEs );
 
         padstackset.clear();
+        padstackCache.clear();
+
+        // Build the images of all the modules in parallel, they are registered
+        // in the library in board order below.
+        std::vector<IMAGE*> images( items.GetCount(), nullptr );
+        std::atomic<size_t> nextItem( 0 );
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                       images.size() );
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        auto image_lambda = [&]() -> size_t
+        {
+            size_t num = 0;
+
+            for( size_t i = nextItem.fetch_add( 1 ); i < images.size();
+                 i = nextItem.fetch_add( 1 ) )
+            {
+                images[i] = makeIMAGE( aBoard, (MODULE*) items[i] );
+                images[i]->hash = images[i]->makeHash();
+                num++;
+            }
+
+            return num;
+        };
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, image_lambda );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
 
         for( int m = 0; m<items.GetCount(); ++m )
         {
             MODULE* module = (MODULE*) items[m];
 
-            IMAGE*  image = makeIMAGE( aBoard, module );
+            IMAGE*  image = images[m];
 
             componentId = TO_UTF8( module->GetReference() );
 
@@ -1411,6 +1508,8 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
             pcb->library->AddPadstack( padstack );
         }
 
+        padstackCache.clear();
+
         // copy our SPECCTRA_DB::nets to the pcb->network
         for( unsigned n = 1; n<nets.size(); ++n )
         {
@@ -966,11 +966,12 @@ int PCB_EDITOR_CONTROL::PlaceTarget( const TOOL_EVENT& aEvent )
 static bool mergeZones( BOARD_COMMIT& aCommit, std::vector<ZONE_CONTAINER *>& aOriginZones,
         std::vector<ZONE_CONTAINER *>& aMergedZones )
 {
+    std::vector<const SHAPE_POLY_SET*> outlines;
+
     for( unsigned int i = 1; i < aOriginZones.size(); i++ )
-    {
-        aOriginZones[0]->Outline()->BooleanAdd( *aOriginZones[i]->Outline(),
-                                                SHAPE_POLY_SET::PM_FAST );
-    }
+        outlines.push_back( aOriginZones[i]->Outline() );
+
+    aOriginZones[0]->Outline()->BooleanAdd( outlines, SHAPE_POLY_SET::PM_FAST );
 
     aOriginZones[0]->Outline()->Simplify( SHAPE_POLY_SET::PM_FAST );
 
@@ -26,6 +26,8 @@
 #include <thread>
 #include <algorithm>
 #include <future>
+#include <map>
+#include <string>
 
 #include <class_board.h>
 #include <class_zone.h>
@@ -119,12 +121,27 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
     m_boardOutline.RemoveAllContours();
     m_brdOutlinesValid = m_board->GetBoardPolygonOutlines( m_boardOutline );
 
+    // The hashes of the filler inputs are saved with the fills.  When checking, the zones
+    // filled from the same inputs are up to date, and are not filled again.
+    std::map<const ZONE_CONTAINER*, MD5_HASH> inputsHashes = computeFillInputsHashes();
+
     for( auto zone : aZones )
     {
         // Keepout zones are not filled
         if( zone->GetIsKeepout() )
             continue;
 
+        if( aCheck && zone->IsFilled() && zone->GetFillInputsHash().IsValid() )
+        {
+            auto inputsHash = inputsHashes.find( zone );
+
+            if( inputsHash != inputsHashes.end()
+                    && inputsHash->second == zone->GetFillInputsHash() )
+            {
+                continue;
+            }
+        }
+
         if( m_commit )
             m_commit->Modify( zone );
 
@@ -140,6 +157,10 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         zone->UnFill();
     }
 
+    // Nothing to check
+    if( toFill.empty() )
+        return true;
+
     std::atomic<size_t> nextItem( 0 );
     size_t              parallelThreadCount =
             std::min<size_t>( std::thread::hardware_concurrency(), aZones.size() );
@@ -243,6 +264,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 
         zone.m_zone->SetFilledPolysList( poly );
         zone.m_zone->CalculateFilledArea();
+        zone.m_zone->SetFillInputsHash( inputsHashes[zone.m_zone] );
 
         if( aCheck && zone.m_zone->GetHashValue() != poly.GetHash() )
             outOfDate = true;
@@ -283,7 +305,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 
         for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
         {
-            toFill[i].m_zone->CacheTriangulation();
+            // A fill is only spread over several threads when the zones are not already
+            // triangulated in parallel
+            toFill[i].m_zone->CacheTriangulation( parallelThreadCount <= 1 );
             num++;
 
             if( m_progressReporter )
@@ -339,6 +363,373 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 }
 
 
+namespace
+{
+
+/// The version of the filler, hashed with its inputs.  Increase it when the filler changes
+/// the fill it builds from the same inputs, so the fills of older versions are out of date.
+const int FILL_ALGORITHM_VERSION = 1;
+
+
+void hashValue( MD5_HASH& aHash, int aValue )
+{
+    aHash.Hash( aValue );
+}
+
+
+void hashValue( MD5_HASH& aHash, double aValue )
+{
+    aHash.Hash( (uint8_t*) &aValue, sizeof( aValue ) );
+}
+
+
+void hashValue( MD5_HASH& aHash, const wxPoint& aPoint )
+{
+    aHash.Hash( aPoint.x );
+    aHash.Hash( aPoint.y );
+}
+
+
+void hashValue( MD5_HASH& aHash, const wxSize& aSize )
+{
+    aHash.Hash( aSize.x );
+    aHash.Hash( aSize.y );
+}
+
+
+void hashValue( MD5_HASH& aHash, const EDA_RECT& aRect )
+{
+    hashValue( aHash, aRect.GetOrigin() );
+    hashValue( aHash, aRect.GetSize() );
+}
+
+
+void hashValue( MD5_HASH& aHash, const LSET& aLayers )
+{
+    for( PCB_LAYER_ID layer : aLayers.Seq() )
+        aHash.Hash( layer );
+
+    aHash.Hash( PCB_LAYER_ID_COUNT );
+}
+
+
+void hashValue( MD5_HASH& aHash, const std::string& aString )
+{
+    aHash.Hash( (int) aString.size() );
+    aHash.Hash( (uint8_t*) aString.data(), (uint32_t) aString.size() );
+}
+
+
+void hashValue( MD5_HASH& aHash, const MD5_HASH& aValue )
+{
+    hashValue( aHash, aValue.ToHexString() );
+}
+
+
+/**
+ * @return the hash of a list of digests, which does not depend on the order of the list
+ * (the order of the items in the board is not saved).
+ */
+MD5_HASH hashDigests( std::vector<std::string>& aDigests )
+{
+    MD5_HASH hash;
+
+    std::sort( aDigests.begin(), aDigests.end() );
+
+    for( const std::string& digest : aDigests )
+        hashValue( hash, digest );
+
+    hash.Finalize();
+    return hash;
+}
+
+
+std::string padDigest( const D_PAD* aPad )
+{
+    MD5_HASH hash;
+
+    hashValue( hash, aPad->GetNetCode() );
+    hashValue( hash, aPad->GetLayerSet() );
+    hashValue( hash, aPad->GetPosition() );
+    hashValue( hash, aPad->GetOrientation() );
+    hashValue( hash, aPad->GetShape() );
+    hashValue( hash, aPad->GetAnchorPadShape() );
+    hashValue( hash, aPad->GetSize() );
+    hashValue( hash, aPad->GetDelta() );
+    hashValue( hash, aPad->GetOffset() );
+    hashValue( hash, aPad->GetDrillSize() );
+    hashValue( hash, aPad->GetDrillShape() );
+    hashValue( hash, aPad->GetAttribute() );
+    hashValue( hash, aPad->GetRoundRectRadiusRatio() );
+    hashValue( hash, aPad->GetChamferRectRatio() );
+    hashValue( hash, aPad->GetChamferPositions() );
+    hashValue( hash, aPad->GetCustomShapeInZoneOpt() );
+    hashValue( hash, aPad->GetCustomShapeAsPolygon().GetHash() );
+    hashValue( hash, aPad->GetClearance() );
+
+    hash.Finalize();
+    return hash.ToHexString();
+}
+
+
+std::string trackDigest( const TRACK* aTrack )
+{
+    MD5_HASH hash;
+
+    hashValue( hash, aTrack->Type() );
+    hashValue( hash, aTrack->GetNetCode() );
+    hashValue( hash, aTrack->GetLayerSet() );
+    hashValue( hash, aTrack->GetStart() );
+    hashValue( hash, aTrack->GetEnd() );
+    hashValue( hash, aTrack->GetWidth() );
+    hashValue( hash, aTrack->GetClearance() );
+
+    if( aTrack->Type() == PCB_ARC_T )
+        hashValue( hash, static_cast<const ARC*>( aTrack )->GetMid() );
+
+    hash.Finalize();
+    return hash.ToHexString();
+}
+
+
+std::string graphicDigest( const BOARD_ITEM* aItem )
+{
+    MD5_HASH hash;
+
+    hashValue( hash, aItem->Type() );
+    hashValue( hash, aItem->GetLayerSet() );
+    hashValue( hash, aItem->GetBoundingBox() );
+
+    if( const DRAWSEGMENT* seg = dynamic_cast<const DRAWSEGMENT*>( aItem ) )
+    {
+        hashValue( hash, seg->GetShape() );
+        hashValue( hash, seg->GetStart() );
+        hashValue( hash, seg->GetEnd() );
+        hashValue( hash, seg->GetAngle() );
+        hashValue( hash, seg->GetWidth() );
+        hashValue( hash, seg->GetBezControl1() );
+        hashValue( hash, seg->GetBezControl2() );
+        hashValue( hash, seg->GetPolyShape().GetHash() );
+
+        // The polygons of footprint graphics are relative to the footprint
+        if( const MODULE* module = dynamic_cast<const MODULE*>( seg->GetParent() ) )
+        {
+            hashValue( hash, module->GetPosition() );
+            hashValue( hash, module->GetOrientation() );
+        }
+    }
+    else if( const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( aItem ) )
+    {
+        hashValue( hash, text->GetText().IsEmpty() );
+        hashValue( hash, text->IsVisible() );
+        hashValue( hash, text->GetTextBox() );
+        hashValue( hash, text->GetTextPos() );
+        hashValue( hash, text->GetTextAngle() );
+    }
+
+    hash.Finalize();
+    return hash.ToHexString();
+}
+
+
+std::string zoneDigest( const ZONE_CONTAINER* aZone )
+{
+    MD5_HASH hash;
+
+    hashValue( hash, aZone->Outline()->GetHash() );
+    hashValue( hash, aZone->GetLayerSet() );
+    hashValue( hash, aZone->GetNetCode() );
+    hashValue( hash, (int) aZone->GetPriority() );
+    hashValue( hash, aZone->GetIsKeepout() );
+    hashValue( hash, aZone->GetDoNotAllowCopperPour() );
+    hashValue( hash, aZone->GetCornerSmoothingType() );
+    hashValue( hash, (int) aZone->GetCornerRadius() );
+    hashValue( hash, aZone->GetClearance() );
+    hashValue( hash, aZone->GetZoneClearance() );
+
+    hash.Finalize();
+    return hash.ToHexString();
+}
+
+}
+
+
+std::map<const ZONE_CONTAINER*, MD5_HASH> ZONE_FILLER::computeFillInputsHashes()
+{
+    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    std::list<ZONE_CONTAINER*>   zones = m_board->GetZoneList( true );
+
+    // The digests of the items, which are inputs of all the zones around them
+    std::vector<std::pair<D_PAD*, std::string>>      pads;
+    std::vector<std::pair<TRACK*, std::string>>      tracks;
+    std::vector<std::pair<BOARD_ITEM*, std::string>> graphics;
+    std::map<const ZONE_CONTAINER*, std::string>     zoneDigests;
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            pads.emplace_back( pad, padDigest( pad ) );
+
+        graphics.emplace_back( &module->Reference(), graphicDigest( &module->Reference() ) );
+        graphics.emplace_back( &module->Value(), graphicDigest( &module->Value() ) );
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            graphics.emplace_back( item, graphicDigest( item ) );
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        graphics.emplace_back( item, graphicDigest( item ) );
+
+    for( TRACK* track : m_board->Tracks() )
+        tracks.emplace_back( track, trackDigest( track ) );
+
+    for( ZONE_CONTAINER* zone : zones )
+        zoneDigests[zone] = zoneDigest( zone );
+
+    // First the inputs of each zone taken alone
+    std::map<const ZONE_CONTAINER*, MD5_HASH> hashes;
+
+    for( ZONE_CONTAINER* zone : zones )
+    {
+        if( zone->GetIsKeepout() )
+            continue;
+
+        PCB_LAYER_ID             layer = zone->GetLayer();
+        std::vector<std::string> items;
+        MD5_HASH                 hash;
+
+        hashValue( hash, FILL_ALGORITHM_VERSION );
+        hashValue( hash, bds.m_MaxError );
+        hashValue( hash, bds.m_CopperEdgeClearance );
+        hashValue( hash, bds.GetBiggestClearanceValue() );
+        hashValue( hash, bds.m_ZoneUseNoOutlineInFill );
+        hashValue( hash, m_brdOutlinesValid );
+        hashValue( hash, m_boardOutline.GetHash() );
+
+        hashValue( hash, zoneDigests[zone] );
+        hashValue( hash, zone->GetMinThickness() );
+        hashValue( hash, static_cast<int>( zone->GetPadConnection() ) );
+        hashValue( hash, zone->GetThermalReliefGap() );
+        hashValue( hash, zone->GetThermalReliefCopperBridge() );
+        hashValue( hash, static_cast<int>( zone->GetFillMode() ) );
+        hashValue( hash, zone->GetHatchFillTypeThickness() );
+        hashValue( hash, zone->GetHatchFillTypeGap() );
+        hashValue( hash, zone->GetHatchFillTypeOrientation() );
+        hashValue( hash, zone->GetHatchFillTypeSmoothingLevel() );
+        hashValue( hash, zone->GetHatchFillTypeSmoothingValue() );
+
+        // Items outside of the area used by buildCopperItemClearances() do not change the fill
+        EDA_RECT area = zone->GetBoundingBox();
+        area.Inflate( std::max( bds.GetBiggestClearanceValue(), zone->GetClearance() )
+                      + Millimeter2iu( 0.002 ) );
+
+        for( const auto& pad : pads )
+        {
+            if( !pad.first->IsOnLayer( layer ) && pad.first->GetDrillSize().x == 0
+                    && pad.first->GetDrillSize().y == 0 )
+            {
+                continue;
+            }
+
+            int      thermalGap = zone->GetThermalReliefGap( pad.first );
+            EDA_RECT bbox = pad.first->GetBoundingBox();
+            bbox.Inflate( std::max( pad.first->GetClearance(), thermalGap ) );
+
+            if( !bbox.Intersects( area ) )
+                continue;
+
+            // The connection of the pad to this zone
+            MD5_HASH padHash;
+            hashValue( padHash, pad.second );
+            hashValue( padHash, static_cast<int>( zone->GetPadConnection( pad.first ) ) );
+            hashValue( padHash, thermalGap );
+            hashValue( padHash, zone->GetThermalReliefCopperBridge( pad.first ) );
+            padHash.Finalize();
+
+            items.push_back( padHash.ToHexString() );
+        }
+
+        for( const auto& track : tracks )
+        {
+            if( track.first->IsOnLayer( layer )
+                    && track.first->GetBoundingBox().Intersects( area ) )
+            {
+                items.push_back( track.second );
+            }
+        }
+
+        for( const auto& item : graphics )
+        {
+            if( ( item.first->IsOnLayer( layer ) || item.first->IsOnLayer( Edge_Cuts ) )
+                    && item.first->GetBoundingBox().Intersects( area ) )
+            {
+                items.push_back( item.second );
+            }
+        }
+
+        // All the zones around, for the priorities and the colinear corners
+        for( ZONE_CONTAINER* other : zones )
+        {
+            if( other != zone && zone->CommonLayerExists( other->GetLayerSet() )
+                    && other->GetBoundingBox().Intersects( area ) )
+            {
+                items.push_back( zoneDigests[other] );
+            }
+        }
+
+        hashValue( hash, hashDigests( items ) );
+        hash.Finalize();
+
+        hashes[zone] = hash;
+    }
+
+    // The insulated islands are the filled areas not connected to a pad of the net, possibly
+    // through items or zones anywhere in the board, so the fills of the zones of a net depend
+    // on all the copper of the net
+    std::map<int, std::vector<std::string>> nets;
+
+    for( const auto& pad : pads )
+    {
+        if( pad.first->GetNetCode() > 0 )
+            nets[pad.first->GetNetCode()].push_back( pad.second );
+    }
+
+    for( const auto& track : tracks )
+    {
+        if( track.first->GetNetCode() > 0 )
+            nets[track.first->GetNetCode()].push_back( track.second );
+    }
+
+    for( const auto& zoneHash : hashes )
+    {
+        if( zoneHash.first->GetNetCode() > 0 && zoneHash.first->IsOnCopperLayer() )
+            nets[zoneHash.first->GetNetCode()].push_back( zoneHash.second.ToHexString() );
+    }
+
+    std::map<int, MD5_HASH> netHashes;
+
+    for( auto& net : nets )
+        netHashes[net.first] = hashDigests( net.second );
+
+    for( auto& zoneHash : hashes )
+    {
+        int netCode = zoneHash.first->GetNetCode();
+
+        if( netCode <= 0 || !zoneHash.first->IsOnCopperLayer() )
+            continue;
+
+        MD5_HASH hash;
+        hashValue( hash, zoneHash.second );
+        hashValue( hash, netHashes[netCode] );
+        hash.Finalize();
+
+        zoneHash.second = hash;
+    }
+
+    return hashes;
+}
+
+
 /**
  * Return true if the given pad has a thermal connection with the given zone.
  */
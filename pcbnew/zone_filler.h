@@ -26,6 +26,7 @@
 #ifndef __ZONE_FILLER_H
 #define __ZONE_FILLER_H
 
+#include <map>
 #include <vector>
 #include <class_zone.h>
 
@@ -47,6 +48,17 @@ public:
 
 private:
 
+    /**
+     * Function computeFillInputsHashes
+     * Computes, for all the zones of the board, the hash of the inputs of the filler: the zone
+     * outline and settings, the board settings and outlines, the items around the zone and,
+     * for zones with a net, all the copper of the net (which decides what is an insulated
+     * island).  The same inputs give the same fill, so a zone filled from inputs with the same
+     * hash does not need to be filled again.
+     * m_boardOutline must be up to date.
+     */
+    std::map<const ZONE_CONTAINER*, MD5_HASH> computeFillInputsHashes();
+
     void addKnockout( D_PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
     void addKnockout( BOARD_ITEM* aItem, int aGap, bool aIgnoreLineWidth, SHAPE_POLY_SET& aHoles );
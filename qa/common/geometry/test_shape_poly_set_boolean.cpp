@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <vector>
+
+
+/**
+ * Builds a polyset holding one axis-aligned square, optionally with a square hole.
+ */
+static SHAPE_POLY_SET buildSquare( int aX, int aY, int aSize, int aHole = 0 )
+{
+    SHAPE_POLY_SET   poly;
+    SHAPE_LINE_CHAIN outline;
+
+    outline.Append( aX, aY );
+    outline.Append( aX + aSize, aY );
+    outline.Append( aX + aSize, aY + aSize );
+    outline.Append( aX, aY + aSize );
+    outline.SetClosed( true );
+    poly.AddOutline( outline );
+
+    if( aHole > 0 )
+    {
+        int              c = aSize / 2;
+        SHAPE_LINE_CHAIN hole;
+
+        hole.Append( aX + c - aHole, aY + c - aHole );
+        hole.Append( aX + c - aHole, aY + c + aHole );
+        hole.Append( aX + c + aHole, aY + c + aHole );
+        hole.Append( aX + c + aHole, aY + c - aHole );
+        hole.SetClosed( true );
+        poly.AddHole( hole );
+    }
+
+    return poly;
+}
+
+
+/**
+ * Operands for the union tests: a row of overlapping squares, one of them with a hole
+ * which is partially covered by its neighbour, and one disjoint square.
+ */
+struct BooleanFixture
+{
+    std::vector<SHAPE_POLY_SET> m_shapes;
+
+    BooleanFixture()
+    {
+        m_shapes.push_back( buildSquare( 0, 0, 100 ) );
+        m_shapes.push_back( buildSquare( 80, 0, 100, 30 ) );
+        m_shapes.push_back( buildSquare( 160, 20, 100 ) );
+        m_shapes.push_back( buildSquare( 1000, 1000, 50 ) );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ShapePolySetBoolean, BooleanFixture )
+
+
+/**
+ * Check that a single n-ary union gives the same area as adding the operands one by one
+ */
+BOOST_AUTO_TEST_CASE( NaryUnionMatchesPairwise )
+{
+    SHAPE_POLY_SET pairwise;
+
+    for( const SHAPE_POLY_SET& shape : m_shapes )
+        pairwise.BooleanAdd( shape, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET                     nary;
+    std::vector<const SHAPE_POLY_SET*> operands;
+
+    for( const SHAPE_POLY_SET& shape : m_shapes )
+        operands.push_back( &shape );
+
+    nary.BooleanAdd( operands, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( nary.OutlineCount(), pairwise.OutlineCount() );
+    BOOST_CHECK_EQUAL( nary.OutlineCount(), 2 );
+    BOOST_CHECK_EQUAL( nary.HoleCount( 0 ) + nary.HoleCount( 1 ), 1 );
+
+    // Both results must cover exactly the same area
+    SHAPE_POLY_SET diff;
+    diff.BooleanSubtract( nary, pairwise, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_EQUAL( diff.OutlineCount(), 0 );
+
+    diff.BooleanSubtract( pairwise, nary, SHAPE_POLY_SET::PM_FAST );
+    BOOST_CHECK_EQUAL( diff.OutlineCount(), 0 );
+}
+
+
+/**
+ * Check that the existing content of the set is part of the n-ary union
+ */
+BOOST_AUTO_TEST_CASE( NaryUnionKeepsOwnPolygons )
+{
+    SHAPE_POLY_SET                     poly = m_shapes[0];
+    std::vector<const SHAPE_POLY_SET*> operands = { &m_shapes[3] };
+
+    poly.BooleanAdd( operands, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 2 );
+    BOOST_CHECK( poly.Contains( VECTOR2I( 50, 50 ) ) );
+    BOOST_CHECK( poly.Contains( VECTOR2I( 1025, 1025 ) ) );
+}
+
+
+/**
+ * Check that a union of nothing leaves the set untouched (apart from normalization)
+ */
+BOOST_AUTO_TEST_CASE( NaryUnionEmpty )
+{
+    SHAPE_POLY_SET poly = m_shapes[1];
+
+    poly.BooleanAdd( std::vector<const SHAPE_POLY_SET*>(), SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 1 );
+    BOOST_CHECK_EQUAL( poly.COutline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_EQUAL( poly.CHole( 0, 0 ).PointCount(), 4 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
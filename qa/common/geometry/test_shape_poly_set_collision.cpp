@@ -26,6 +26,10 @@
 
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+#include <cmath>
+#include <limits>
 
 #include "fixtures_geometry.h"
 
@@ -193,4 +197,105 @@ BOOST_AUTO_TEST_CASE( CollideVertexWithClearance )
     }
 }
 
+/**
+ * Builds a closed star shaped contour with aCount vertices alternating between two radii.
+ */
+static SHAPE_LINE_CHAIN buildStar( const VECTOR2I& aCenter, int aInner, int aOuter, int aCount,
+                                   bool aClockwise )
+{
+    SHAPE_LINE_CHAIN star;
+
+    for( int ii = 0; ii < aCount; ii++ )
+    {
+        double angle = 2.0 * M_PI * ii / aCount * ( aClockwise ? -1 : 1 );
+        int    radius = ( ii % 2 ) ? aInner : aOuter;
+
+        star.Append( aCenter.x + KiROUND( radius * cos( angle ) ),
+                     aCenter.y + KiROUND( radius * sin( angle ) ) );
+    }
+
+    star.SetClosed( true );
+
+    return star;
+}
+
+
+/**
+ * Checks the queries on polygons large enough to be edge indexed against the same queries
+ * made directly on their contours, then checks that the index follows a modification.
+ */
+BOOST_AUTO_TEST_CASE( LargePolygonQueries )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.AddOutline( buildStar( { 0, 0 }, 8000, 10000, 1000, false ) );
+    poly.AddHole( buildStar( { 0, 0 }, 2000, 3000, 200, true ) );
+    poly.AddOutline( buildStar( { 30000, 0 }, 4000, 5000, 20, false ) );
+
+    auto containsRef = [&]( const VECTOR2I& aP, int aAccuracy )
+    {
+        for( int ii = 0; ii < poly.OutlineCount(); ii++ )
+        {
+            bool inHole = false;
+
+            for( int hole = 0; hole < poly.HoleCount( ii ); hole++ )
+                inHole |= poly.CHole( ii, hole ).PointInside( aP, 1 );
+
+            if( poly.COutline( ii ).PointInside( aP, aAccuracy ) && !inHole )
+                return true;
+        }
+
+        return false;
+    };
+
+    // Query each point several times, so the index gets built
+    for( int x = -12000; x <= 36000; x += 487 )
+    {
+        for( int y = -12000; y <= 12000; y += 487 )
+        {
+            VECTOR2I pt( x, y );
+            int      distRef = std::numeric_limits<int>::max();
+
+            for( int ii = 0; ii < poly.OutlineCount(); ii++ )
+            {
+                for( auto it = poly.CIterateSegmentsWithHoles( ii ); it; it++ )
+                    distRef = std::min( distRef, ( *it ).Distance( pt ) );
+            }
+
+            bool inside = containsRef( pt, 0 );
+
+            BOOST_CHECK_EQUAL( poly.Contains( pt ), inside );
+            BOOST_CHECK_EQUAL( poly.Collide( pt, 0 ), inside );
+            BOOST_CHECK_EQUAL( poly.Collide( pt, 300 ), inside || distRef <= 300 );
+
+            // Distance() considers the points on the edges as inside
+            BOOST_CHECK_EQUAL( poly.Distance( pt ), containsRef( pt, 1 ) ? 0 : distRef );
+        }
+    }
+
+    for( int ii = 0; ii < poly.COutline( 0 ).PointCount(); ii += 37 )
+    {
+        VECTOR2I vertex = poly.COutline( 0 ).CPoint( ii );
+
+        BOOST_CHECK( poly.PointOnEdge( vertex ) );
+        BOOST_CHECK( !poly.Contains( vertex ) );
+        BOOST_CHECK( poly.Contains( vertex, -1, 2 ) );
+    }
+
+    poly.Move( VECTOR2I( 100000, 0 ) );
+
+    BOOST_CHECK( !poly.Contains( VECTOR2I( 5000, 0 ) ) );
+    BOOST_CHECK( poly.Contains( VECTOR2I( 105000, 0 ) ) );
+
+    // The index must also follow a modification made through a non-const reference once it
+    // has been built
+    for( int ii = 0; ii < 5; ii++ )
+        BOOST_CHECK( poly.Contains( VECTOR2I( 105000, 0 ) ) );
+
+    poly.Outline( 0 ).Move( VECTOR2I( 0, 50000 ) );
+
+    BOOST_CHECK( !poly.Contains( VECTOR2I( 105000, 0 ) ) );
+    BOOST_CHECK( poly.Contains( VECTOR2I( 105000, 50000 ) ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,207 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+#include <cmath>
+#include <cstdlib>
+
+
+/**
+ * Builds a closed regular polygon, with its first corner on the right of the centre.
+ */
+static SHAPE_LINE_CHAIN buildRegularPolygon( const VECTOR2I& aCentre, int aRadius, int aCorners )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCorners; ++ii )
+    {
+        double angle = 2.0 * M_PI * ii / aCorners;
+
+        chain.Append( aCentre.x + KiROUND( aRadius * cos( angle ) ),
+                      aCentre.y + KiROUND( aRadius * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+
+    return chain;
+}
+
+
+/**
+ * @return the total area of the triangles of a triangulated polygon.
+ */
+static double triangleArea( const SHAPE_POLY_SET::TRIANGULATED_POLYGON& aTriPoly )
+{
+    double area = 0.0;
+
+    for( size_t ii = 0; ii < aTriPoly.GetTriangleCount(); ++ii )
+    {
+        VECTOR2I a, b, c;
+        aTriPoly.GetTriangle( ii, a, b, c );
+
+        area += std::abs( (double) ( b - a ).Cross( c - a ) ) / 2.0;
+    }
+
+    return area;
+}
+
+
+/**
+ * A row of outlines large enough for the triangulation to be spread over several threads,
+ * of different sizes so they are not triangulated in the order of the outlines.
+ */
+struct TriangulationFixture
+{
+    SHAPE_POLY_SET m_polys;
+
+    TriangulationFixture()
+    {
+        for( int ii = 0; ii < 40; ++ii )
+            m_polys.AddOutline( buildRegularPolygon( { ii * 30000, 0 }, 10000, 50 + ii * 5 ) );
+    }
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ShapePolySetTriangulation, TriangulationFixture )
+
+
+/**
+ * Check that each outline gives one triangulated polygon, in the order of the outlines,
+ * which covers the same area
+ */
+BOOST_AUTO_TEST_CASE( OutlinesInOrder )
+{
+    BOOST_REQUIRE_GE( m_polys.TotalVertices(), 4096 );
+
+    m_polys.CacheTriangulation();
+
+    BOOST_REQUIRE( m_polys.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( (int) m_polys.TriangulatedPolyCount(), m_polys.OutlineCount() );
+
+    for( int ii = 0; ii < m_polys.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN&                     outline = m_polys.COutline( ii );
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* triPoly = m_polys.TriangulatedPolygon( ii );
+
+        BOOST_TEST_CONTEXT( "Outline " << ii )
+        {
+            BOOST_CHECK_EQUAL( triPoly->GetVertexCount(), (size_t) outline.PointCount() );
+            BOOST_CHECK_EQUAL( triPoly->GetTriangleCount(), (size_t) outline.PointCount() - 2 );
+            BOOST_CHECK_EQUAL( triPoly->Triangles().size(), triPoly->GetTriangleCount() );
+            BOOST_CHECK( outline.BBox().Contains( triPoly->Vertices().front() ) );
+            BOOST_CHECK_CLOSE( triangleArea( *triPoly ), std::abs( outline.Area() ), 1e-6 );
+        }
+    }
+}
+
+
+/**
+ * Check that a set triangulated by the calling thread only gives the same polygons
+ */
+BOOST_AUTO_TEST_CASE( SerialMatchesParallel )
+{
+    SHAPE_POLY_SET serial = m_polys;
+
+    m_polys.CacheTriangulation();
+    serial.CacheTriangulation( false );
+
+    BOOST_REQUIRE( serial.IsTriangulationUpToDate() );
+    BOOST_REQUIRE_EQUAL( serial.TriangulatedPolyCount(), m_polys.TriangulatedPolyCount() );
+
+    for( unsigned int ii = 0; ii < serial.TriangulatedPolyCount(); ++ii )
+    {
+        BOOST_CHECK_EQUAL( serial.TriangulatedPolygon( ii )->GetTriangleCount(),
+                           m_polys.TriangulatedPolygon( ii )->GetTriangleCount() );
+        BOOST_CHECK( serial.TriangulatedPolygon( ii )->Vertices()
+                     == m_polys.TriangulatedPolygon( ii )->Vertices() );
+    }
+}
+
+
+/**
+ * Check that an unchanged set is not triangulated again, and that copies share the
+ * triangulation
+ */
+BOOST_AUTO_TEST_CASE( CachedOnHash )
+{
+    m_polys.CacheTriangulation();
+
+    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* first = m_polys.TriangulatedPolygon( 0 );
+
+    m_polys.CacheTriangulation();
+    BOOST_CHECK_EQUAL( m_polys.TriangulatedPolygon( 0 ), first );
+
+    SHAPE_POLY_SET copy = m_polys;
+
+    BOOST_CHECK( copy.IsTriangulationUpToDate() );
+    BOOST_CHECK( copy.GetHash() == m_polys.GetHash() );
+
+    copy.CacheTriangulation();
+    BOOST_CHECK_EQUAL( copy.TriangulatedPolygon( 0 ), first );
+
+    // Modifying the copy triangulates it again, but leaves the original alone
+    copy.Move( VECTOR2I( 10, 10 ) );
+    BOOST_CHECK( !copy.IsTriangulationUpToDate() );
+
+    copy.CacheTriangulation();
+    BOOST_CHECK( copy.IsTriangulationUpToDate() );
+    BOOST_CHECK( copy.TriangulatedPolygon( 0 ) != first );
+    BOOST_CHECK_EQUAL( m_polys.TriangulatedPolygon( 0 ), first );
+}
+
+
+/**
+ * Check the triangulation of a polygon with holes, which is fractured first
+ */
+BOOST_AUTO_TEST_CASE( Holes )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.AddOutline( buildRegularPolygon( { 0, 0 }, 100000, 64 ) );
+    poly.AddHole( buildRegularPolygon( { -40000, 0 }, 20000, 16 ) );
+    poly.AddHole( buildRegularPolygon( { 40000, 0 }, 20000, 16 ) );
+
+    double expected = std::abs( poly.COutline( 0 ).Area() ) - std::abs( poly.CHole( 0, 0 ).Area() )
+                      - std::abs( poly.CHole( 0, 1 ).Area() );
+
+    poly.CacheTriangulation();
+
+    BOOST_REQUIRE( poly.IsTriangulationUpToDate() );
+
+    // The set itself is not fractured
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 2 );
+
+    double area = 0.0;
+
+    for( unsigned int ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
+        area += triangleArea( *poly.TriangulatedPolygon( ii ) );
+
+    BOOST_CHECK_CLOSE( area, expected, 1e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <eda_text.h>
+
+
+BOOST_AUTO_TEST_SUITE( EdaText )
+
+
+/**
+ * Check that the stroke font text drawn through BASIC_GAL reaches the segment callback
+ */
+BOOST_AUTO_TEST_CASE( TextToSegments )
+{
+    EDA_TEXT text( "KiCad" );
+
+    text.SetTextSize( wxSize( 10000, 10000 ) );
+    text.SetTextPos( wxPoint( 0, 0 ) );
+
+    std::vector<wxPoint> segments;
+    text.TransformTextShapeToSegmentList( segments );
+
+    BOOST_CHECK( !segments.empty() );
+    BOOST_CHECK_EQUAL( segments.size() % 2, 0 );
+
+    // The overbar adds its own segments
+    EDA_TEXT overbarText( "~KiCad~" );
+
+    overbarText.SetTextSize( wxSize( 10000, 10000 ) );
+    overbarText.SetTextPos( wxPoint( 0, 0 ) );
+
+    std::vector<wxPoint> overbarSegments;
+    overbarText.TransformTextShapeToSegmentList( overbarSegments );
+
+    BOOST_CHECK_GT( overbarSegments.size(), segments.size() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
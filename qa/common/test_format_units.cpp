@@ -26,7 +26,11 @@
 #include <base_units.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 struct UnitFixture
 {
@@ -74,4 +78,57 @@ BOOST_AUTO_TEST_CASE( wxPointUnitFormat )
 }
 
 
+/**
+ * The values are formatted with integer arithmetic, which must give the same text as the
+ * printf() formatting of the value in millimeters used before.
+ */
+BOOST_AUTO_TEST_CASE( IntUnitFormatMatchesPrintf )
+{
+    auto reference = []( int aValue )
+    {
+        char   buf[50];
+        double engUnits = aValue / IU_PER_MM;
+        int    len;
+
+        if( engUnits != 0.0 && fabs( engUnits ) <= 0.0001 )
+        {
+            len = snprintf( buf, sizeof( buf ), "%.10f", engUnits );
+
+            while( --len > 0 && buf[len] == '0' )
+                buf[len] = '\0';
+
+            if( buf[len] == '.' )
+                buf[len] = '\0';
+            else
+                ++len;
+        }
+        else
+        {
+            len = snprintf( buf, sizeof( buf ), "%.10g", engUnits );
+        }
+
+        return std::string( buf, len );
+    };
+
+    std::vector<int> values = { 0, std::numeric_limits<int>::min(),
+                                std::numeric_limits<int>::max() };
+
+    for( int v = -2000; v <= 2000; ++v )
+        values.push_back( v );
+
+    for( long long scale = 1; scale <= 1000000000; scale *= 10 )
+    {
+        for( int delta = -3; delta <= 3; ++delta )
+        {
+            values.push_back( (int) scale + delta );
+            values.push_back( (int) -scale + delta );
+            values.push_back( (int) ( scale * 2 / 3 ) + delta );
+        }
+    }
+
+    for( int value : values )
+        BOOST_CHECK_EQUAL( FormatInternalUnits( value ), reference( value ) );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,254 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Recache benchmark: draws every item of a board the way VIEW::UpdateItems() does when
+ * the whole view is recached, i.e. painters record the drawing commands on worker threads
+ * (RECORDING_GAL) and the commands are then replayed on the target GAL.  The recording
+ * is timed for an increasing number of threads, so the scaling can be checked without
+ * an OpenGL context.
+ *
+ * The target is the base GAL, whose drawing calls do nothing: the replay time only covers
+ * the dispatching of the commands, not the vertex generation and the upload of a real
+ * backend, which run on the main thread whatever the number of threads.  So the speedup
+ * reported is the one of the recording only; the record + replay total is compared with
+ * drawing the items directly into the target, and is a lower bound of a real recache.
+ *
+ * Usage: qa_gal_recache <board file> [iterations]
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+#include <qa_utils/utility_program.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <gal/gal_display_options.h>
+#include <gal/recording_gal.h>
+#include <pcb_painter.h>
+#include <profile.h>
+#include <view/view.h>
+
+#include <wx/msgout.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+struct DRAW_JOB
+{
+    const BOARD_ITEM* m_item;
+    std::vector<int>  m_layers;
+};
+
+
+/**
+ * Records all the jobs using a given number of threads.
+ * @return the number of recorded commands.
+ */
+static size_t recordJobs( const std::vector<DRAW_JOB>& aJobs, KIGFX::GAL* aTarget,
+                          const KIGFX::PCB_PAINTER& aPainter, size_t aThreads,
+                          std::vector<std::vector<KIGFX::RECORDING_GAL::COMMAND>>& aCommands )
+{
+    std::vector<std::unique_ptr<KIGFX::RECORDING_GAL>> recorders;
+    std::vector<std::unique_ptr<KIGFX::PAINTER>>       painters;
+
+    for( size_t ii = 0; ii < aThreads; ++ii )
+    {
+        recorders.emplace_back( new KIGFX::RECORDING_GAL( aTarget ) );
+        painters.emplace_back( aPainter.Clone( recorders.back().get() ) );
+    }
+
+    aCommands.clear();
+    aCommands.resize( aJobs.size() );
+
+    std::atomic<size_t> nextJob( 0 );
+
+    auto worker = [&]( size_t aThread ) -> size_t
+    {
+        KIGFX::RECORDING_GAL* recorder = recorders[aThread].get();
+        KIGFX::PAINTER*       painter = painters[aThread].get();
+        size_t                count = 0;
+
+        for( size_t i = nextJob.fetch_add( 1 ); i < aJobs.size(); i = nextJob.fetch_add( 1 ) )
+        {
+            recorder->Clear();
+
+            for( int layer : aJobs[i].m_layers )
+                painter->Draw( aJobs[i].m_item, layer );
+
+            aCommands[i] = recorder->TakeCommands();
+            count += aCommands[i].size();
+        }
+
+        return count;
+    };
+
+    std::vector<std::future<size_t>> returns;
+
+    for( size_t ii = 0; ii < aThreads; ++ii )
+        returns.emplace_back( std::async( std::launch::async, worker, ii ) );
+
+    size_t count = 0;
+
+    for( auto& ret : returns )
+        count += ret.get();
+
+    return count;
+}
+
+
+int main( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+
+    if( argc < 2 )
+    {
+        printf( "Usage: %s <board file> [iterations]\n", argv[0] );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int iterations = 5;
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !board )
+        return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+
+    // Zones are triangulated when the board is loaded into the view, not when they are drawn
+    for( ZONE_CONTAINER* zone : board->Zones() )
+        zone->CacheTriangulation();
+
+    std::vector<DRAW_JOB> jobs;
+
+    auto addJob = [&jobs]( const BOARD_ITEM* aItem )
+    {
+        int layers[KIGFX::VIEW::VIEW_MAX_LAYERS], layers_count;
+
+        aItem->ViewGetLayers( layers, layers_count );
+        jobs.push_back( { aItem, std::vector<int>( layers, layers + layers_count ) } );
+    };
+
+    for( BOARD_ITEM* drawing : board->Drawings() )
+        addJob( drawing );
+
+    for( TRACK* track : board->Tracks() )
+        addJob( track );
+
+    for( MODULE* module : board->Modules() )
+    {
+        addJob( module );
+        module->RunOnChildren( addJob );
+    }
+
+    for( ZONE_CONTAINER* zone : board->Zones() )
+        addJob( zone );
+
+    KIGFX::GAL_DISPLAY_OPTIONS options;
+    KIGFX::GAL                 target( options );
+    KIGFX::PCB_PAINTER         painter( &target );
+
+    target.SetZoomFactor( 1.0 );
+    target.ComputeWorldScreenMatrix();
+
+    std::vector<std::vector<KIGFX::RECORDING_GAL::COMMAND>> commands;
+    size_t maxThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+    double serialRecordTime = 0.0;
+    double directTime = 0.0;
+
+    printf( "%d items\n", (int) jobs.size() );
+
+    // Reference: the painter draws straight into the target, as without parallel recaching
+    for( int i = 0; i < iterations; i++ )
+    {
+        PROF_COUNTER counter;
+
+        for( const DRAW_JOB& job : jobs )
+        {
+            for( int layer : job.m_layers )
+                painter.Draw( job.m_item, layer );
+        }
+
+        counter.Stop();
+        directTime += counter.msecs();
+    }
+
+    directTime /= iterations;
+    printf( "direct drawing: %8.2f ms\n", directTime );
+
+    std::vector<size_t> threadCounts;
+
+    for( size_t threads = 1; threads < maxThreads; threads *= 2 )
+        threadCounts.push_back( threads );
+
+    threadCounts.push_back( maxThreads );
+
+    for( size_t threads : threadCounts )
+    {
+        double recordTime = 0.0;
+        double replayTime = 0.0;
+        size_t count = 0;
+
+        for( int i = 0; i < iterations; i++ )
+        {
+            PROF_COUNTER recordCounter;
+            count = recordJobs( jobs, &target, painter, threads, commands );
+            recordCounter.Stop();
+
+            // The replay runs on the calling thread, as in VIEW::UpdateItems()
+            PROF_COUNTER replayCounter;
+
+            for( const auto& itemCommands : commands )
+                KIGFX::RECORDING_GAL::Replay( itemCommands, &target );
+
+            replayCounter.Stop();
+
+            recordTime += recordCounter.msecs();
+            replayTime += replayCounter.msecs();
+        }
+
+        recordTime /= iterations;
+        replayTime /= iterations;
+
+        if( threads == 1 )
+            serialRecordTime = recordTime;
+
+        printf( "%2d thread(s): %8.2f ms record (speedup %.2fx, recording only) + %8.2f ms "
+                "serial replay = %8.2f ms (%.2fx direct drawing), %d commands\n",
+                (int) threads, recordTime, serialRecordTime / recordTime, replayTime,
+                recordTime + replayTime, directTime / ( recordTime + replayTime ),
+                (int) count );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
@@ -0,0 +1,176 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Micro-benchmark of the segment queries: runs the same queries against line chains with the
+ * scalar SEG code, segment by segment, and with SEG_BATCH, checks they agree and prints the
+ * times.
+ *
+ * Usage: qa_kimath_seg_batch_benchmark [points per chain] [iterations]
+ */
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+#include <profile.h>
+
+#include "seg_batch_fixture.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+
+/**
+ * Runs aOp on all the chains and queries aIterations times.
+ * @return the mean time in milliseconds, and the sum of the results in aChecksum.
+ */
+template <typename OP>
+static double timeQueries( const SEG_BATCH_FIXTURE& aFixture, int aIterations, long long& aChecksum,
+                           OP aOp )
+{
+    PROF_COUNTER counter;
+
+    for( int i = 0; i < aIterations; i++ )
+    {
+        aChecksum = 0;
+
+        for( size_t c = 0; c < aFixture.m_chains.size(); ++c )
+        {
+            for( const SEG& query : aFixture.m_queries )
+                aChecksum += aOp( c, query );
+        }
+    }
+
+    counter.Stop();
+
+    return counter.msecs() / aIterations;
+}
+
+
+int main( int argc, char** argv )
+{
+    int points = 5000;
+    int iterations = 3;
+
+    if( argc > 1 )
+        points = std::max( 2, atoi( argv[1] ) );
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    SEG_BATCH_FIXTURE      fixture( 20, points, 500 );
+    std::vector<SEG_BATCH> batches;
+
+    PROF_COUNTER buildCounter;
+
+    for( const SHAPE_LINE_CHAIN& chain : fixture.m_chains )
+        batches.emplace_back( chain );
+
+    buildCounter.Stop();
+
+    printf( "%d chains of %d points, %d queries per chain, batches built in %.2f ms\n",
+            (int) fixture.m_chains.size(), points, (int) fixture.m_queries.size(),
+            buildCounter.msecs() );
+    printf( "%-20s %12s %12s %9s\n", "query", "scalar", "batch", "speedup" );
+
+    bool ok = true;
+
+    auto report = [&]( const char* aName, double aScalar, long long aScalarSum, double aBatch,
+                       long long aBatchSum )
+    {
+        printf( "%-20s %10.2fms %10.2fms %8.2fx%s\n", aName, aScalar, aBatch, aScalar / aBatch,
+                aScalarSum == aBatchSum ? "" : "  MISMATCH" );
+
+        ok &= aScalarSum == aBatchSum;
+    };
+
+    for( int clearance : { 0, 200, 5000 } )
+    {
+        long long scalarSum, batchSum;
+        char      name[32];
+
+        double scalar = timeQueries( fixture, iterations, scalarSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return ScalarCollide( fixture.m_chains[aChain], aQuery, clearance );
+                } );
+
+        double batch = timeQueries( fixture, iterations, batchSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return batches[aChain].Collide( aQuery, clearance );
+                } );
+
+        snprintf( name, sizeof( name ), "Collide (%d)", clearance );
+        report( name, scalar, scalarSum, batch, batchSum );
+    }
+
+    {
+        long long scalarSum, batchSum;
+        int       index;
+
+        double scalar = timeQueries( fixture, iterations, scalarSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return ScalarSquaredDistance( fixture.m_chains[aChain], aQuery.A, index );
+                } );
+
+        double batch = timeQueries( fixture, iterations, batchSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return batches[aChain].SquaredDistance( aQuery.A );
+                } );
+
+        report( "Distance (point)", scalar, scalarSum, batch, batchSum );
+
+        scalar = timeQueries( fixture, iterations, scalarSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return ScalarSquaredDistance( fixture.m_chains[aChain], aQuery, index );
+                } );
+
+        batch = timeQueries( fixture, iterations, batchSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return batches[aChain].SquaredDistance( aQuery );
+                } );
+
+        report( "Distance (segment)", scalar, scalarSum, batch, batchSum );
+
+        scalar = timeQueries( fixture, iterations, scalarSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return ScalarIntersect( fixture.m_chains[aChain], aQuery, index ) ? index : -1;
+                } );
+
+        batch = timeQueries( fixture, iterations, batchSum,
+                [&]( size_t aChain, const SEG& aQuery )
+                {
+                    return batches[aChain].Intersect( aQuery, &index ) ? index : -1;
+                } );
+
+        report( "Intersect", scalar, scalarSum, batch, batchSum );
+    }
+
+    return ok ? 0 : 1;
+}
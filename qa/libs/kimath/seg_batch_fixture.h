@@ -0,0 +1,154 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SEG_BATCH_FIXTURE_H
+#define SEG_BATCH_FIXTURE_H
+
+#include <geometry/seg.h>
+#include <geometry/shape_line_chain.h>
+
+#include <random>
+#include <vector>
+
+
+/**
+ * The scalar queries SEG_BATCH replaces: the SEG queries run on each segment in turn.
+ */
+inline int ScalarCollide( const SHAPE_LINE_CHAIN& aChain, const SEG& aSeg, int aClearance )
+{
+    for( int i = 0; i < aChain.SegmentCount(); ++i )
+    {
+        if( aChain.CSegment( i ).Collide( aSeg, aClearance ) )
+            return i;
+    }
+
+    return -1;
+}
+
+
+template <typename QUERY>
+SEG::ecoord ScalarSquaredDistance( const SHAPE_LINE_CHAIN& aChain, const QUERY& aQuery,
+                                   int& aIndex )
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+    aIndex = -1;
+
+    for( int i = 0; i < aChain.SegmentCount(); ++i )
+    {
+        SEG::ecoord d = aChain.CSegment( i ).SquaredDistance( aQuery );
+
+        if( d < best )
+        {
+            best = d;
+            aIndex = i;
+        }
+    }
+
+    return best;
+}
+
+
+inline OPT_VECTOR2I ScalarIntersect( const SHAPE_LINE_CHAIN& aChain, const SEG& aSeg,
+                                     int& aIndex )
+{
+    for( int i = 0; i < aChain.SegmentCount(); ++i )
+    {
+        if( OPT_VECTOR2I ip = aChain.CSegment( i ).Intersect( aSeg ) )
+        {
+            aIndex = i;
+            return ip;
+        }
+    }
+
+    aIndex = -1;
+    return OPT_VECTOR2I();
+}
+
+
+/**
+ * Random chains looking like the ones of tracks and zone outlines (random walks made of
+ * horizontal, vertical and 45 degree segments, with a few slightly off 45 degree ones and a
+ * few long jumps), and random query segments around them.
+ */
+struct SEG_BATCH_FIXTURE
+{
+    SEG_BATCH_FIXTURE( int aChainCount = 20, int aPointCount = 700, int aQueryCount = 200 )
+    {
+        std::mt19937                       rng( 42 );
+        std::uniform_int_distribution<int> dir( 0, 7 );
+        std::uniform_int_distribution<int> len( 0, 20000 );
+        std::uniform_int_distribution<int> jitter( -1, 1 );
+        std::uniform_int_distribution<int> coord( -1000000, 1000000 );
+        std::uniform_int_distribution<int> kind( 0, 19 );
+
+        static const int dx[] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+        static const int dy[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+        for( int c = 0; c < aChainCount; ++c )
+        {
+            SHAPE_LINE_CHAIN chain;
+            VECTOR2I         p( coord( rng ), coord( rng ) );
+
+            for( int i = 0; i < aPointCount; ++i )
+            {
+                chain.Append( p, true );
+
+                int d = dir( rng );
+                int l = len( rng );
+                int k = kind( rng );
+
+                if( k == 0 )
+                    p = VECTOR2I( coord( rng ), coord( rng ) );
+                else if( k == 1 )
+                    p += VECTOR2I( dx[d] * l + jitter( rng ), dy[d] * l );
+                else
+                    p += VECTOR2I( dx[d] * l, dy[d] * l );
+            }
+
+            chain.SetClosed( c % 2 == 1 );
+            m_chains.push_back( chain );
+        }
+
+        // Queries near the chains
+        std::uniform_int_distribution<int> pick( 0, aPointCount - 1 );
+        std::uniform_int_distribution<int> offset( -3000, 3000 );
+
+        for( int q = 0; q < aQueryCount; ++q )
+        {
+            const SHAPE_LINE_CHAIN& chain = m_chains[q % aChainCount];
+            VECTOR2I a = chain.CPoint( pick( rng ) ) + VECTOR2I( offset( rng ), offset( rng ) );
+            VECTOR2I b = a;
+
+            if( q % 3 )
+                b += VECTOR2I( offset( rng ) * 4, offset( rng ) * 4 );
+
+            m_queries.emplace_back( a, b );
+        }
+    }
+
+    std::vector<SHAPE_LINE_CHAIN> m_chains;
+    std::vector<SEG>              m_queries;
+};
+
+#endif // SEG_BATCH_FIXTURE_H
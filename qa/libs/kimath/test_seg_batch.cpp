@@ -0,0 +1,191 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Test suite for SEG_BATCH: the batched queries must give exactly the results of running
+ * the SEG queries on every segment of the chain.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+
+#include "seg_batch_fixture.h"
+
+
+BOOST_FIXTURE_TEST_SUITE( SegBatch, SEG_BATCH_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( Segments )
+{
+    for( const SHAPE_LINE_CHAIN& chain : m_chains )
+    {
+        SEG_BATCH batch( chain );
+
+        BOOST_REQUIRE_EQUAL( batch.SegmentCount(), chain.SegmentCount() );
+
+        for( int i = 0; i < chain.SegmentCount(); ++i )
+            BOOST_CHECK( batch.Segment( i ) == chain.CSegment( i ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( Collide )
+{
+    for( const SHAPE_LINE_CHAIN& chain : m_chains )
+    {
+        SEG_BATCH batch( chain );
+
+        for( const SEG& query : m_queries )
+        {
+            for( int clearance : { 0, 1, 150, 5000 } )
+            {
+                int expected = ScalarCollide( chain, query, clearance );
+
+                BOOST_CHECK_EQUAL( batch.Collide( query, clearance ), expected );
+                BOOST_CHECK_EQUAL( batch.Collide( query.A, clearance ),
+                                   ScalarCollide( chain, SEG( query.A, query.A ), clearance ) );
+                BOOST_CHECK_EQUAL( chain.Collide( query, clearance ), expected >= 0 );
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SquaredDistance )
+{
+    for( const SHAPE_LINE_CHAIN& chain : m_chains )
+    {
+        SEG_BATCH batch( chain );
+
+        for( const SEG& query : m_queries )
+        {
+            int index, expectedIndex;
+
+            SEG::ecoord expected = ScalarSquaredDistance( chain, query.A, expectedIndex );
+
+            BOOST_CHECK_EQUAL( batch.SquaredDistance( query.A, &index ), expected );
+            BOOST_CHECK_EQUAL( index, expectedIndex );
+
+            expected = ScalarSquaredDistance( chain, query, expectedIndex );
+
+            BOOST_CHECK_EQUAL( batch.SquaredDistance( query, &index ), expected );
+            BOOST_CHECK_EQUAL( index, expectedIndex );
+
+            int expectedDistance = INT_MAX;
+
+            for( int i = 0; i < chain.SegmentCount(); ++i )
+            {
+                expectedDistance = std::min( expectedDistance,
+                                             chain.CSegment( i ).Distance( query.A ) );
+            }
+
+            BOOST_CHECK_EQUAL( chain.Distance( query.A, true ), expectedDistance );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( Intersect )
+{
+    for( const SHAPE_LINE_CHAIN& chain : m_chains )
+    {
+        SEG_BATCH batch( chain );
+
+        for( const SEG& query : m_queries )
+        {
+            int          index, expectedIndex;
+            OPT_VECTOR2I expected = ScalarIntersect( chain, query, expectedIndex );
+            OPT_VECTOR2I ip = batch.Intersect( query, &index );
+
+            BOOST_REQUIRE_EQUAL( !!ip, !!expected );
+            BOOST_CHECK_EQUAL( index, expectedIndex );
+
+            if( ip )
+                BOOST_CHECK_EQUAL( *ip, *expected );
+        }
+    }
+}
+
+
+/**
+ * The bounding boxes of segments going right to left or bottom to top were not normalized
+ * by SHAPE_LINE_CHAIN::Collide(), so they could be missed.
+ */
+BOOST_AUTO_TEST_CASE( ReversedSegments )
+{
+    SHAPE_LINE_CHAIN chain(
+            std::vector<VECTOR2I>{ VECTOR2I( 1000, 0 ), VECTOR2I( 0, 0 ), VECTOR2I( 0, -1000 ) } );
+
+    // Queries going right to left and top to bottom too
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( 500, 10 ), VECTOR2I( 400, 10 ) ), 20 ) );
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( -10, -400 ), VECTOR2I( -10, -500 ) ), 20 ) );
+    BOOST_CHECK( !chain.Collide( SEG( VECTOR2I( 500, 30 ), VECTOR2I( 400, 30 ) ), 20 ) );
+    BOOST_CHECK( !chain.Collide( SEG( VECTOR2I( 500, 10 ), VECTOR2I( 400, 10 ) ), 0 ) );
+
+    // Crossing segments collide without clearance
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( 500, -100 ), VECTOR2I( 500, 100 ) ), 0 ) );
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( 500, 100 ), VECTOR2I( 500, -100 ) ), 0 ) );
+    BOOST_CHECK( chain.Collide( SEG( VECTOR2I( 100, -500 ), VECTOR2I( -100, -500 ) ), 0 ) );
+}
+
+
+/**
+ * The closing segment of a closed chain ends on the first point, whatever the block it
+ * falls in.
+ */
+BOOST_AUTO_TEST_CASE( ClosingSegment )
+{
+    SHAPE_LINE_CHAIN single( std::vector<VECTOR2I>{ VECTOR2I( 100, 100 ) } );
+    SHAPE_LINE_CHAIN square( std::vector<VECTOR2I>{ VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ),
+                                                    VECTOR2I( 1000, 1000 ), VECTOR2I( 0, 1000 ) } );
+
+    single.SetClosed( true );
+    square.SetClosed( true );
+
+    BOOST_CHECK_EQUAL( SEG_BATCH( single ).Collide( VECTOR2I( 100, 110 ), 20 ), 0 );
+    BOOST_CHECK_EQUAL( SEG_BATCH( square ).Collide( VECTOR2I( -10, 500 ), 20 ), 3 );
+    BOOST_CHECK( SEG_BATCH( square ).Segment( 3 ) == square.CSegment( 3 ) );
+
+    square.SetClosed( false );
+
+    BOOST_CHECK_EQUAL( SEG_BATCH( square ).Collide( VECTOR2I( -10, 500 ), 20 ), -1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    SEG_BATCH empty;
+    int       index = 0;
+
+    BOOST_CHECK_EQUAL( empty.SegmentCount(), 0 );
+    BOOST_CHECK_EQUAL( empty.Collide( VECTOR2I( 0, 0 ), 100 ), -1 );
+    BOOST_CHECK( empty.SquaredDistance( VECTOR2I( 0, 0 ), &index ) == VECTOR2I::ECOORD_MAX );
+    BOOST_CHECK_EQUAL( index, -1 );
+    BOOST_CHECK( !empty.Intersect( SEG( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ) ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
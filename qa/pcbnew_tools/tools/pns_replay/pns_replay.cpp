@@ -0,0 +1,394 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <profile.h>
+
+#include <router/pns_debug_decorator.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_logger.h>
+#include <router/pns_router.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Router session replay: runs a session recorded by the interactive router (see the
+ * RouterSessionLog advanced config key) through PNS::ROUTER without the GUI, reports
+ * the latency of each kind of event and checks the resulting geometry against the one
+ * recorded in the session.
+ *
+ * The board has to be the one the session was recorded on, as the router world and the
+ * design rules are built from it.
+ */
+
+enum PNS_REPLAY_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    SESSION_LOAD_FAILED,
+    GEOMETRY_MISMATCH
+};
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE:  return "start route";
+    case PNS::LOGGER::EVT_START_DRAG:   return "start drag";
+    case PNS::LOGGER::EVT_FIX:          return "fix";
+    case PNS::LOGGER::EVT_MOVE:         return "move";
+    case PNS::LOGGER::EVT_UNFIX:        return "unfix";
+    case PNS::LOGGER::EVT_COMMIT:       return "commit";
+    case PNS::LOGGER::EVT_ABORT:        return "stop";
+    case PNS::LOGGER::EVT_SWITCH_LAYER: return "switch layer";
+    case PNS::LOGGER::EVT_TOGGLE_VIA:   return "toggle via";
+    case PNS::LOGGER::EVT_FLIP_POSTURE: return "flip posture";
+    }
+
+    return "unknown";
+}
+
+
+/**
+ * Finds the router item an event referred to: by the UUID of its parent board item or,
+ * for items created by the router during the session, among the items under the cursor.
+ */
+static PNS::ITEM* findItem( PNS::ROUTER& aRouter,
+                            const std::map<std::string, BOARD_CONNECTED_ITEM*>& aBoardItems,
+                            const PNS::LOGGER::ITEM_REF& aRef, const VECTOR2I& aPos )
+{
+    auto parent = aBoardItems.find( aRef.m_uuid );
+
+    if( parent != aBoardItems.end() )
+    {
+        if( PNS::ITEM* item = aRouter.GetWorld()->FindItemByParent( parent->second ) )
+            return item;
+    }
+
+    for( PNS::ITEM* item : aRouter.QueryHoverItems( aPos ).CItems() )
+    {
+        if( (int) item->Kind() == aRef.m_kind && item->Net() == aRef.m_net
+                && item->Layers().Overlaps( aRef.m_layer ) )
+        {
+            return item;
+        }
+    }
+
+    return nullptr;
+}
+
+
+static void replayEvent( PNS::ROUTER& aRouter, const PNS::LOGGER::EVENT_ENTRY& aEvent,
+                         const std::vector<PNS::ITEM*>& aItems )
+{
+    PNS::ITEM* item = aItems.empty() ? nullptr : aItems[0];
+
+    switch( aEvent.m_type )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE:
+        aRouter.StartRouting( aEvent.m_pos, item, aEvent.m_arg );
+        break;
+
+    case PNS::LOGGER::EVT_START_DRAG:
+    {
+        PNS::ITEM_SET items;
+
+        for( PNS::ITEM* dragged : aItems )
+        {
+            if( dragged )
+                items.Add( dragged );
+        }
+
+        aRouter.StartDragging( aEvent.m_pos, items, aEvent.m_arg );
+        break;
+    }
+
+    case PNS::LOGGER::EVT_FIX:
+        aRouter.FixRoute( aEvent.m_pos, item, aEvent.m_arg != 0 );
+        break;
+
+    case PNS::LOGGER::EVT_MOVE:
+        aRouter.Move( aEvent.m_pos, item );
+        break;
+
+    case PNS::LOGGER::EVT_UNFIX:
+        aRouter.UndoLastSegment();
+        break;
+
+    case PNS::LOGGER::EVT_COMMIT:
+        aRouter.CommitRouting();
+        break;
+
+    case PNS::LOGGER::EVT_ABORT:
+        aRouter.StopRouting();
+        break;
+
+    case PNS::LOGGER::EVT_SWITCH_LAYER:
+        aRouter.SwitchLayer( aEvent.m_arg );
+        break;
+
+    case PNS::LOGGER::EVT_TOGGLE_VIA:
+        aRouter.ToggleViaPlacement();
+        break;
+
+    case PNS::LOGGER::EVT_FLIP_POSTURE:
+        aRouter.FlipPosture();
+        break;
+    }
+}
+
+
+/**
+ * Compares the world of the router with a recorded group of items.
+ * @return the number of items found only in one of them.
+ */
+static int compareWorld( PNS::ROUTER& aRouter, const std::vector<std::string>& aRecorded )
+{
+    std::vector<std::string> current = PNS::LOGGER::FormatNode( aRouter.GetWorld() );
+    std::vector<std::string> recorded = aRecorded;
+    std::vector<std::string> diff;
+
+    std::sort( recorded.begin(), recorded.end() );
+    std::set_symmetric_difference( current.begin(), current.end(), recorded.begin(),
+                                   recorded.end(), std::back_inserter( diff ) );
+
+    return (int) diff.size();
+}
+
+
+static void printLatencies( const std::string& aName, std::vector<double>& aTimes )
+{
+    if( aTimes.empty() )
+        return;
+
+    std::sort( aTimes.begin(), aTimes.end() );
+
+    auto percentile = [&aTimes]( double aPercent )
+                      {
+                          size_t i = (size_t) ( aPercent / 100.0 * ( aTimes.size() - 1 ) + 0.5 );
+                          return aTimes[i];
+                      };
+
+    double total = 0.0;
+
+    for( double t : aTimes )
+        total += t;
+
+    printf( "%-14s %7d %10.3f %10.3f %10.3f %10.3f %10.3f\n", aName.c_str(), (int) aTimes.size(),
+            total / aTimes.size(), percentile( 50 ), percentile( 90 ), percentile( 99 ),
+            aTimes.back() );
+}
+
+
+int pns_replay_main_func( int argc, char** argv )
+{
+    if( argc < 3 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board file> <session log>" << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !board )
+        return PNS_REPLAY_RET_CODES::LOAD_FAILED;
+
+    std::ifstream session( argv[2] );
+
+    if( !session )
+    {
+        std::cerr << "Cannot open session log " << argv[2] << std::endl;
+        return PNS_REPLAY_RET_CODES::SESSION_LOAD_FAILED;
+    }
+
+    std::map<std::string, BOARD_CONNECTED_ITEM*> boardItems;
+
+    for( TRACK* track : board->Tracks() )
+        boardItems[track->m_Uuid.AsString().ToStdString()] = track;
+
+    for( MODULE* module : board->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            boardItems[pad->m_Uuid.AsString().ToStdString()] = pad;
+    }
+
+    for( ZONE_CONTAINER* zone : board->Zones() )
+        boardItems[zone->m_Uuid.AsString().ToStdString()] = zone;
+
+    PNS_KICAD_IFACE_BASE iface;
+    PNS::ROUTER          router;
+
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+    PNS::SIZES_SETTINGS   sizes;
+
+    iface.SetBoard( board.get() );
+    iface.SetDebugDecorator( new PNS::DEBUG_DECORATOR );
+    router.SetInterface( &iface );
+    router.LoadSettings( &settings );
+    router.UpdateSizes( sizes );
+
+    PROF_COUNTER syncCounter;
+    router.SyncWorld();
+    syncCounter.Stop();
+
+    std::map<PNS::LOGGER::EVENT_TYPE, std::vector<double>> latencies;
+    std::vector<double>                                    allLatencies;
+    std::vector<std::string>                               group;
+    std::string                                            groupName;
+    std::string                                            line;
+    bool                                                   inGroup = false;
+    int                                                    mismatches = 0;
+    int                                                    lineNumber = 0;
+
+    while( std::getline( session, line ) )
+    {
+        lineNumber++;
+
+        std::istringstream tokens( line );
+        std::string        keyword;
+
+        tokens >> keyword;
+
+        if( inGroup )
+        {
+            if( keyword != "endgroup" )
+            {
+                group.push_back( line );
+                continue;
+            }
+
+            inGroup = false;
+
+            int diff = compareWorld( router, group );
+
+            if( diff )
+            {
+                printf( "%s: %d item(s) differ from the recorded ones (line %d)\n",
+                        groupName.c_str(), diff, lineNumber );
+                mismatches++;
+            }
+            else
+            {
+                printf( "%s: %d items match\n", groupName.c_str(), (int) group.size() );
+            }
+        }
+        else if( keyword == "group" )
+        {
+            tokens >> groupName;
+            group.clear();
+            inGroup = true;
+        }
+        else if( keyword == "sync" )
+        {
+            // The recorded router re-read the board here.  Our world is kept by the router
+            // only, so check the board was not modified outside of it.
+            size_t   count;
+            uint64_t hash;
+
+            tokens >> count >> hash;
+
+            std::vector<std::string> current = PNS::LOGGER::FormatNode( router.GetWorld() );
+
+            if( current.size() != count || PNS::LOGGER::HashNode( current ) != hash )
+            {
+                printf( "sync: the board was modified outside the router (line %d)\n",
+                        lineNumber );
+                mismatches++;
+            }
+        }
+        else if( keyword == "settings" )
+        {
+            int mode;
+
+            if( !PNS::LOGGER::ParseSettings( line, mode, settings, sizes ) )
+            {
+                std::cerr << "Malformed settings at line " << lineNumber << std::endl;
+                return PNS_REPLAY_RET_CODES::SESSION_LOAD_FAILED;
+            }
+
+            router.SetMode( (PNS::ROUTER_MODE) mode );
+            router.UpdateSizes( sizes );
+        }
+        else if( keyword == "event" )
+        {
+            PNS::LOGGER::EVENT_ENTRY event;
+
+            if( !PNS::LOGGER::ParseEvent( line, event ) )
+            {
+                std::cerr << "Malformed event at line " << lineNumber << std::endl;
+                return PNS_REPLAY_RET_CODES::SESSION_LOAD_FAILED;
+            }
+
+            std::vector<PNS::ITEM*> items;
+
+            for( const PNS::LOGGER::ITEM_REF& ref : event.m_items )
+                items.push_back( findItem( router, boardItems, ref, event.m_pos ) );
+
+            PROF_COUNTER counter;
+            replayEvent( router, event, items );
+            counter.Stop();
+
+            latencies[event.m_type].push_back( counter.msecs() );
+            allLatencies.push_back( counter.msecs() );
+        }
+    }
+
+    printf( "\nWorld sync: %.3f ms\n\n", syncCounter.msecs() );
+    printf( "%-14s %7s %10s %10s %10s %10s %10s\n", "event [ms]", "count", "mean", "p50", "p90",
+            "p99", "max" );
+
+    for( auto& eventLatencies : latencies )
+        printLatencies( eventName( eventLatencies.first ), eventLatencies.second );
+
+    printLatencies( "all", allLatencies );
+
+    if( mismatches )
+    {
+        printf( "\nThe replayed geometry differs from the recorded one.\n" );
+        return PNS_REPLAY_RET_CODES::GEOMETRY_MISMATCH;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pns_replay",
+        "Replay a recorded interactive router session and report the event latencies",
+        pns_replay_main_func,
+} );
@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <profile.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Polygon operation benchmark: runs the boolean and offset operations used by the zone
+ * filler and the plotter on the zones of a board, and compares the union of the filled
+ * areas done one operand at a time with the single pass n-ary union.
+ *
+ * Usage: polygon_ops <board file> [iterations]
+ */
+
+enum POLYGON_OPS_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULT_MISMATCH
+};
+
+
+/**
+ * Runs aOp aIterations times and returns the mean time in milliseconds.
+ */
+template <typename Op>
+static double timeOp( int aIterations, Op aOp )
+{
+    PROF_COUNTER counter;
+
+    for( int i = 0; i < aIterations; i++ )
+        aOp();
+
+    counter.Stop();
+
+    return counter.msecs() / aIterations;
+}
+
+
+/**
+ * @return true if both sets cover the same area.
+ */
+static bool sameArea( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+{
+    SHAPE_POLY_SET diff;
+
+    diff.BooleanSubtract( aA, aB, SHAPE_POLY_SET::PM_FAST );
+
+    if( diff.OutlineCount() )
+        return false;
+
+    diff.BooleanSubtract( aB, aA, SHAPE_POLY_SET::PM_FAST );
+
+    return diff.OutlineCount() == 0;
+}
+
+
+int polygon_ops_main( int argc, char** argv )
+{
+    if( argc < 2 )
+    {
+        printf( "Usage: %s <board file> [iterations]\n", argv[0] );
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    int iterations = 5;
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !board )
+        return POLYGON_OPS_RET_CODES::LOAD_FAILED;
+
+    std::map<PCB_LAYER_ID, std::vector<const ZONE_CONTAINER*>> layerZones;
+
+    for( ZONE_CONTAINER* zone : board->Zones() )
+    {
+        if( zone->IsOnCopperLayer() && !zone->GetIsKeepout() )
+            layerZones[zone->GetLayer()].push_back( zone );
+    }
+
+    bool ok = true;
+
+    printf( "%-12s %6s %10s %10s %10s %10s %10s\n", "layer", "zones", "pairwise", "n-ary",
+            "subtract", "inflate", "fracture" );
+
+    for( const auto& entry : layerZones )
+    {
+        const std::vector<const ZONE_CONTAINER*>& zones = entry.second;
+        std::vector<const SHAPE_POLY_SET*>        filledAreas;
+        std::vector<const SHAPE_POLY_SET*>        outlines;
+
+        for( const ZONE_CONTAINER* zone : zones )
+        {
+            filledAreas.push_back( &zone->GetFilledPolysList() );
+            outlines.push_back( zone->Outline() );
+        }
+
+        SHAPE_POLY_SET pairwise;
+        SHAPE_POLY_SET nary;
+
+        double pairwiseTime = timeOp( iterations, [&]()
+                {
+                    pairwise.RemoveAllContours();
+
+                    for( const SHAPE_POLY_SET* area : filledAreas )
+                        pairwise.BooleanAdd( *area, SHAPE_POLY_SET::PM_FAST );
+                } );
+
+        double naryTime = timeOp( iterations, [&]()
+                {
+                    nary.RemoveAllContours();
+                    nary.BooleanAdd( filledAreas, SHAPE_POLY_SET::PM_FAST );
+                } );
+
+        if( !sameArea( pairwise, nary ) )
+        {
+            printf( "%s: n-ary union differs from the pairwise union\n",
+                    board->GetLayerName( entry.first ).ToStdString().c_str() );
+            ok = false;
+        }
+
+        // Knock the filled areas out of the zone outlines, as the filler does with the
+        // clearance areas of the other items.
+        double subtractTime = timeOp( iterations, [&]()
+                {
+                    for( const SHAPE_POLY_SET* outline : outlines )
+                    {
+                        SHAPE_POLY_SET poly = *outline;
+                        poly.BooleanSubtract( nary, SHAPE_POLY_SET::PM_FAST );
+                    }
+                } );
+
+        // Deflate and reinflate the filled areas by half the min width, as the filler does
+        // to remove the too thin copper.
+        double inflateTime = timeOp( iterations, [&]()
+                {
+                    for( size_t ii = 0; ii < zones.size(); ++ii )
+                    {
+                        SHAPE_POLY_SET poly = *filledAreas[ii];
+                        int            halfWidth = zones[ii]->GetMinThickness() / 2;
+
+                        poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
+                        poly.Deflate( halfWidth, 16 );
+                        poly.Inflate( halfWidth, 16 );
+                    }
+                } );
+
+        double fractureTime = timeOp( iterations, [&]()
+                {
+                    SHAPE_POLY_SET poly = nary;
+                    poly.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                } );
+
+        printf( "%-12s %6d %8.2fms %8.2fms %8.2fms %8.2fms %8.2fms\n",
+                board->GetLayerName( entry.first ).ToStdString().c_str(), (int) zones.size(),
+                pairwiseTime, naryTime, subtractTime, inflateTime, fractureTime );
+    }
+
+    return ok ? KI_TEST::RET_CODES::OK : POLYGON_OPS_RET_CODES::RESULT_MISMATCH;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "polygon_ops",
+        "Benchmark the zone polygon operations of a PCB",
+        polygon_ops_main,
+} );
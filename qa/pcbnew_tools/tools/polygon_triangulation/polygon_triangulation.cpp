@@ -238,7 +238,7 @@ int polygon_triangulation_main( int argc, char *argv[] )
                 auto zone = brd->GetArea( areaId );
                 SHAPE_POLY_SET poly = zone->GetFilledPolysList();
 
-                poly.CacheTriangulation();
+                poly.CacheTriangulation( false );
 
                 (void) poly;
                 printf("zone %zu/%d\n", ( areaId + 1 ), brd->GetAreaCount() );
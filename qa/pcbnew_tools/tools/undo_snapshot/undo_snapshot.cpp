@@ -0,0 +1,170 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <profile.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Undo snapshot benchmark: takes the undo copies BOARD_COMMIT makes of every item
+ * (via Clone()) and reports how long it took and how much fill geometry was actually
+ * duplicated rather than shared with the live items.  Then restores the copies the
+ * way an undo does (SwapData()).
+ */
+
+enum UNDO_SNAPSHOT_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+struct SNAPSHOT_STATS
+{
+    size_t m_items = 0;
+    size_t m_sharedVertices = 0;
+    size_t m_copiedVertices = 0;
+};
+
+
+static void accountZone( SNAPSHOT_STATS& aStats, const ZONE_CONTAINER* aLive,
+                         const ZONE_CONTAINER* aCopy )
+{
+    const SHAPE_POLY_SET& liveFill = aLive->GetFilledPolysList();
+    const SHAPE_POLY_SET& copyFill = aCopy->GetFilledPolysList();
+
+    if( &liveFill == &copyFill )
+        aStats.m_sharedVertices += liveFill.TotalVertices();
+    else
+        aStats.m_copiedVertices += copyFill.TotalVertices();
+}
+
+
+int undo_snapshot_main_func( int argc, char** argv )
+{
+    std::string filename;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    int iterations = 10;
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return UNDO_SNAPSHOT_RET_CODES::LOAD_FAILED;
+
+    std::vector<BOARD_ITEM*> items;
+
+    for( MODULE* module : board->Modules() )
+        items.push_back( module );
+
+    for( TRACK* track : board->Tracks() )
+        items.push_back( track );
+
+    for( ZONE_CONTAINER* zone : board->Zones() )
+        items.push_back( zone );
+
+    for( BOARD_ITEM* drawing : board->Drawings() )
+        items.push_back( drawing );
+
+    SNAPSHOT_STATS stats;
+    double         cloneTime = 0.0;
+    double         swapTime = 0.0;
+
+    for( int i = 0; i < iterations; i++ )
+    {
+        std::vector<std::unique_ptr<BOARD_ITEM>> copies;
+        copies.reserve( items.size() );
+
+        PROF_COUNTER cloneCounter;
+
+        for( BOARD_ITEM* item : items )
+            copies.emplace_back( static_cast<BOARD_ITEM*>( item->Clone() ) );
+
+        cloneCounter.Stop();
+        cloneTime += cloneCounter.msecs();
+
+        if( i == 0 )
+        {
+            stats.m_items = items.size();
+
+            for( size_t j = 0; j < items.size(); j++ )
+            {
+                if( items[j]->Type() == PCB_ZONE_AREA_T )
+                {
+                    accountZone( stats, static_cast<ZONE_CONTAINER*>( items[j] ),
+                                 static_cast<ZONE_CONTAINER*>( copies[j].get() ) );
+                }
+            }
+        }
+
+        // Undo twice, so the board ends up as it started
+        PROF_COUNTER swapCounter;
+
+        for( size_t j = 0; j < items.size(); j++ )
+        {
+            items[j]->SwapData( copies[j].get() );
+            items[j]->SwapData( copies[j].get() );
+        }
+
+        swapCounter.Stop();
+        swapTime += swapCounter.msecs();
+    }
+
+    const size_t vertexSize = sizeof( VECTOR2I );
+
+    std::cout << "Items: " << stats.m_items << std::endl;
+    std::cout << "Clone (undo snapshot) per commit: " << cloneTime / iterations << " ms"
+              << std::endl;
+    std::cout << "SwapData (undo + redo) per commit: " << swapTime / iterations << " ms"
+              << std::endl;
+    std::cout << "Zone fill data shared with undo copy: "
+              << stats.m_sharedVertices * vertexSize / 1024 << " KiB" << std::endl;
+    std::cout << "Zone fill data duplicated in undo copy: "
+              << stats.m_copiedVertices * vertexSize / 1024 << " KiB" << std::endl;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "undo_snapshot",
+        "Benchmark the undo copies made when committing board changes",
+        undo_snapshot_main_func,
+} );
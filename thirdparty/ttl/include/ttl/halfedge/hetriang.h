@@ -269,6 +269,11 @@ protected:
     EDGE_WEAK_PTR   m_twinEdge;
     EDGE_PTR        m_nextEdgeInFace;
     bool            m_isLeadingEdge;
+
+    /// Position in the list of leading edges (valid only for leading edges)
+    std::list<EDGE_PTR>::iterator m_leadingEdgeIt;
+
+    friend class TRIANGULATION;
 };
 
 class DART; // Forward declaration (class in this namespace)
@@ -289,12 +294,16 @@ protected:
     {
         aEdge->SetAsLeadingEdge();
         m_leadingEdges.push_front( aEdge );
+        aEdge->m_leadingEdgeIt = m_leadingEdges.begin();
     }
 
     bool removeLeadingEdgeFromList( EDGE_PTR& aLeadingEdge );
 
     void cleanAll();
 
+    EDGE_PTR initTwoEnclosingTriangles( const NODE_PTR& aN1, const NODE_PTR& aN2,
+                                        const NODE_PTR& aN3, const NODE_PTR& aN4 );
+
     /** Swaps the edge associated with \e dart in the actual data structure.
      *
      *   <center>
@@ -364,6 +373,20 @@ public:
     EDGE_PTR InitTwoEnclosingTriangles( NODES_CONTAINER::iterator aFirst,
                                         NODES_CONTAINER::iterator aLast );
 
+    /**
+     * Creates an empty triangulation covering the whole integer coordinate range, to be
+     * filled with InsertNode().  Unlike CreateDelaunay(), the enclosing rectangle is kept,
+     * so all the inserted nodes remain interior nodes and can be removed later on.
+     * The corner nodes of the enclosing rectangle have a negative id.
+     */
+    void CreateEmpty();
+
+    /// Inserts a node into a triangulation made with CreateEmpty(), keeping it Delaunay
+    bool InsertNode( const NODE_PTR& aNode );
+
+    /// Removes a node added with InsertNode(), keeping the triangulation Delaunay
+    bool RemoveNode( const NODE_PTR& aNode );
+
     // These two functions are required by TTL for Delaunay triangulation
 
     /// Swaps the edge associated with diagonal
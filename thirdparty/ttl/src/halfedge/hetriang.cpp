@@ -122,6 +122,13 @@ EDGE_PTR TRIANGULATION::InitTwoEnclosingTriangles( NODES_CONTAINER::iterator aFi
     NODE_PTR n3 = std::make_shared<NODE>( xmax + dx, ymax + dy );
     NODE_PTR n4 = std::make_shared<NODE>( xmin - dx, ymax + dy );
 
+    return initTwoEnclosingTriangles( n1, n2, n3, n4 );
+}
+
+
+EDGE_PTR TRIANGULATION::initTwoEnclosingTriangles( const NODE_PTR& aN1, const NODE_PTR& aN2,
+                                                  const NODE_PTR& aN3, const NODE_PTR& aN4 )
+{
     // diagonal
     EDGE_PTR e1d = std::make_shared<EDGE>();
     EDGE_PTR e2d = std::make_shared<EDGE>();
@@ -135,27 +142,27 @@ EDGE_PTR TRIANGULATION::InitTwoEnclosingTriangles( NODES_CONTAINER::iterator aFi
     EDGE_PTR e22 = std::make_shared<EDGE>();
 
     // lower triangle
-    e1d->SetSourceNode( n3 );
+    e1d->SetSourceNode( aN3 );
     e1d->SetNextEdgeInFace( e11 );
     e1d->SetTwinEdge( e2d );
     addLeadingEdge( e1d );
 
-    e11->SetSourceNode( n1 );
+    e11->SetSourceNode( aN1 );
     e11->SetNextEdgeInFace( e12 );
 
-    e12->SetSourceNode( n2 );
+    e12->SetSourceNode( aN2 );
     e12->SetNextEdgeInFace( e1d );
 
     // upper triangle
-    e2d->SetSourceNode( n1 );
+    e2d->SetSourceNode( aN1 );
     e2d->SetNextEdgeInFace( e21 );
     e2d->SetTwinEdge( e1d );
     addLeadingEdge( e2d );
 
-    e21->SetSourceNode( n3 );
+    e21->SetSourceNode( aN3 );
     e21->SetNextEdgeInFace( e22 );
 
-    e22->SetSourceNode( n4 );
+    e22->SetSourceNode( aN4 );
     e22->SetNextEdgeInFace( e2d );
 
     return e11;
@@ -211,6 +218,66 @@ void TRIANGULATION::CreateDelaunay( NODES_CONTAINER::iterator aFirst,
 }
 
 
+void TRIANGULATION::CreateEmpty()
+{
+    cleanAll();
+    m_leadingEdges.clear();
+
+    const int xmin = std::numeric_limits<int>::min();
+    const int xmax = std::numeric_limits<int>::max();
+
+    NODE_PTR corners[4] = { std::make_shared<NODE>( xmin, xmin ),
+                            std::make_shared<NODE>( xmax, xmin ),
+                            std::make_shared<NODE>( xmax, xmax ),
+                            std::make_shared<NODE>( xmin, xmax ) };
+
+    for( NODE_PTR& corner : corners )
+        corner->SetId( -1 );
+
+    initTwoEnclosingTriangles( corners[0], corners[1], corners[2], corners[3] );
+}
+
+
+bool TRIANGULATION::InsertNode( const NODE_PTR& aNode )
+{
+    if( m_leadingEdges.empty() )
+        return false;
+
+    // The most recent triangles are at the front of the list, so the search for the
+    // triangle containing the node starts close to the previous insertion
+    DART     dart = CreateDart();
+    NODE_PTR node = aNode;
+
+    return m_helper->InsertNode<TTLtraits>( dart, node );
+}
+
+
+bool TRIANGULATION::RemoveNode( const NODE_PTR& aNode )
+{
+    if( m_leadingEdges.empty() )
+        return false;
+
+    DART dart = CreateDart();
+
+    if( !ttl::TRIANGULATION_HELPER::LocateTriangle<TTLtraits>( aNode, dart ) )
+        return false;
+
+    // The located triangle has the node as one of its vertices: find a CCW dart leaving it
+    for( int i = 0; i < 3; i++ )
+    {
+        if( dart.GetNode() == aNode )
+        {
+            m_helper->RemoveInteriorNode<TTLtraits>( dart );
+            return true;
+        }
+
+        dart.Alpha0().Alpha1();
+    }
+
+    return false;
+}
+
+
 void TRIANGULATION::RemoveTriangle( EDGE_PTR& aEdge )
 {
   EDGE_PTR e1 = getLeadingEdgeInTriangle( aEdge );
@@ -296,24 +363,15 @@ bool TRIANGULATION::removeLeadingEdgeFromList( EDGE_PTR& aLeadingEdge )
     // Remove the edge from the list of leading edges,
     // but don't delete it.
     // Also set flag for leading edge to false.
-    // Must search from start of list. Since edges are added to the
-    // start of the list during triangulation, this operation will
-    // normally be fast (when used in the triangulation algorithm)
-    std::list<EDGE_PTR>::iterator it;
-    for( it = m_leadingEdges.begin(); it != m_leadingEdges.end(); ++it )
-    {
-        EDGE_PTR edge = *it;
-
-        if( edge == aLeadingEdge )
-        {
-            edge->SetAsLeadingEdge( false );
-            it = m_leadingEdges.erase( it );
+    // Leading edges know their position in the list, so this does not need to search
+    // the list (which would be slow when removing nodes from a large triangulation).
+    if( !aLeadingEdge->IsLeadingEdge() )
+        return false;
 
-            return true;
-        }
-    }
+    aLeadingEdge->SetAsLeadingEdge( false );
+    m_leadingEdges.erase( aLeadingEdge->m_leadingEdgeIt );
 
-    return false;
+    return true;
 }
 
 
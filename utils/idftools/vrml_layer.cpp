@@ -31,6 +31,7 @@
 // 3. a scheme is needed to tell a castellated edge from a plain board edge
 
 
+#include <cstdio>
 #include <sstream>
 #include <string>
 #include <iomanip>
@@ -47,38 +48,51 @@
 // minimum sides to a circle
 #define MIN_NSIDES 6
 
-static void FormatDoublet( double x, double y, int precision, std::string& strx, std::string& stry )
+// format a value in fixed notation with trailing zeros removed; this is called for each
+// vertex written so it avoids the cost of a string stream when possible
+static void FormatFixed( double x, int precision, std::string& strx )
 {
-    std::ostringstream ostr;
+    char buf[64];
+    int  len = snprintf( buf, sizeof( buf ), "%.*f", precision, x );
 
-    ostr << std::fixed << std::setprecision( precision );
+    if( len < 0 || len >= (int) sizeof( buf ) )
+    {
+        std::ostringstream ostr;
 
-    ostr << x;
-    strx = ostr.str();
+        ostr << std::fixed << std::setprecision( precision );
+        ostr << x;
+        strx = ostr.str();
+    }
+    else
+    {
+        // the decimal separator must be a '.' whatever the current C locale
+        for( char* cp = buf; *cp; ++cp )
+        {
+            if( *cp != '-' && ( *cp < '0' || *cp > '9' ) )
+            {
+                *cp = '.';
+                break;
+            }
+        }
 
-    ostr.str( "" );
-    ostr << y;
-    stry = ostr.str();
+        strx.assign( buf, len );
+    }
 
     while( *strx.rbegin() == '0' )
         strx.erase( strx.size() - 1 );
-
-    while( *stry.rbegin() == '0' )
-        stry.erase( stry.size() - 1 );
 }
 
 
-static void FormatSinglet( double x, int precision, std::string& strx )
+static void FormatDoublet( double x, double y, int precision, std::string& strx, std::string& stry )
 {
-    std::ostringstream ostr;
-
-    ostr << std::fixed << std::setprecision( precision );
+    FormatFixed( x, precision, strx );
+    FormatFixed( y, precision, stry );
+}
 
-    ostr << x;
-    strx = ostr.str();
 
-    while( *strx.rbegin() == '0' )
-        strx.erase( strx.size() - 1 );
+static void FormatSinglet( double x, int precision, std::string& strx )
+{
+    FormatFixed( x, precision, strx );
 }
 
 
@@ -309,6 +323,34 @@ void VRML_LAYER::clearTmp( void )
 }
 
 
+// add a copy of all the contours of another layer
+bool VRML_LAYER::AppendLayer( const VRML_LAYER& aLayer )
+{
+    if( fix )
+    {
+        error = "AppendLayer(): no more vertices may be added (Tesselate was previously executed)";
+        return false;
+    }
+
+    for( unsigned int i = 0; i < aLayer.contours.size(); ++i )
+    {
+        int contour = NewContour( aLayer.pth[i] );
+
+        // the vertices are added in the contour order, so the winding (and the
+        // area) of the new contour is the same as the original one
+        for( int vertexIdx : *aLayer.contours[i] )
+        {
+            const VERTEX_3D* vp = aLayer.vertices[vertexIdx];
+
+            if( !AddVertex( contour, vp->x, vp->y ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
 // create a new contour to be populated; returns an index
 // into the contour list or -1 if there are problems
 int VRML_LAYER::NewContour(  bool aPlatedHole )
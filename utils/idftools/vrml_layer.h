@@ -200,6 +200,17 @@ public:
         return contours.size();
     }
 
+    /**
+     * Function AppendLayer
+     * adds a copy of all the contours of another layer to this one; this is used to give
+     * several layers their own copy of the same holes so they can be tesselated concurrently
+     *
+     * @param aLayer is the layer to copy the contours from
+     *
+     * @return bool: true if the contours were added
+     */
+    bool AppendLayer( const VRML_LAYER& aLayer );
+
     /**
      * Function NewContour
      * creates a new list of vertices and returns an index to the list